@@ -13,20 +13,25 @@
 #include "cpp-terminal/private/file.hpp"
 #include "cpp-terminal/terminal.hpp"
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
+#include <iterator>
 
-static std::string replace(const Term::Buffer::int_type& c)
+// Append the characters translating the new lines (on Windows) a chunk at a time.
+static void append(std::string& str, const char* s, const std::size_t& n)
 {
 #if defined(_WIN32)
-  std::string ret;
-  if(static_cast<char>(c) == '\n') ret = "\r\n";
-  else
-    ret.push_back(static_cast<char>(c));
-  return ret;
+  const char* end{s + n};
+  for(const char* found = std::find(s, end, '\n'); found != end; found = std::find(s, end, '\n'))
+  {
+    str.append(s, found);
+    str.append("\r\n");
+    s = found + 1;
+  }
+  str.append(s, end);
 #else
-  std::string ret;
-  ret.push_back(static_cast<char>(c));
-  return ret;
+  str.append(s, n);
 #endif
 }
 
@@ -39,9 +44,76 @@ static bool newline_sequence(const std::string& str)  //https://en.wikipedia.org
 
 int Term::Buffer::sync()
 {
-  const int ret = Term::Private::out.write(m_buffer);
-  m_buffer.clear();
-  return ret;
+  if(m_type == Type::FullBuffered)
+  {
+    if(!m_frame) { flushPutArea(); }
+  }
+  else if(!m_buffer.empty())
+  {
+    Term::Private::out.write(m_buffer);
+    m_buffer.clear();
+  }
+  return 0;
+}
+
+void Term::Buffer::write(const char* s, const std::size_t& n)
+{
+  if(n == 0) return;
+#if defined(_WIN32)
+  std::string str;
+  append(str, s, n);
+  Term::Private::out.write(str);
+#else
+  Term::Private::out.write(s, n);
+#endif
+}
+
+// The put area is only used by FullBuffered buffers, it's created at the first write so Term::cin never allocates it.
+void Term::Buffer::flushPutArea()
+{
+  if(pbase() == nullptr)
+  {
+    if(m_size == 0) return;
+    m_buffer.resize(m_size);
+  }
+  else if(pptr() != pbase())
+  {
+    write(pbase(), static_cast<std::size_t>(pptr() - pbase()));
+    if(m_interval.count() != 0) { m_last_flush = std::chrono::steady_clock::now(); }
+  }
+  setp(&m_buffer[0], &m_buffer[0] + m_buffer.size());
+}
+
+// Grow the put area (in a frame) keeping its content.
+void Term::Buffer::reserve(const std::size_t& size)
+{
+  if(pbase() == nullptr) { flushPutArea(); }
+  if(size <= m_buffer.size()) return;
+  const std::size_t used{static_cast<std::size_t>(pptr() - pbase())};
+  m_buffer.resize(std::max(size, 2 * m_buffer.size()));
+  setp(&m_buffer[0], &m_buffer[0] + m_buffer.size());
+  pbump(static_cast<int>(used));
+}
+
+void Term::Buffer::setFlushPolicy(const std::size_t& size, const std::chrono::microseconds& interval)
+{
+  m_interval = interval;
+  m_size     = size;
+  if(m_frame || m_type != Type::FullBuffered) return;
+  flushPutArea();
+  setp(nullptr, nullptr);  // Created again with the new size at the next write.
+}
+
+void Term::Buffer::beginFrame()
+{
+  if(m_type == Type::FullBuffered) { m_frame = true; }
+}
+
+void Term::Buffer::endFrame()
+{
+  m_frame = false;
+  sync();
+  if(m_type == Type::FullBuffered && m_buffer.size() != m_size) { setp(nullptr, nullptr); }  // Back to the normal size, the capacity is kept for the next frame.
 }
 
 Term::Buffer::Buffer(const Term::Buffer::Type& type, const std::streamsize& size)
@@ -59,7 +131,11 @@ void Term::Buffer::setType(const Term::Buffer::Type& type) { m_type = type; }
 
 std::streambuf* Term::Buffer::setbuf(char* s, std::streamsize n)
 {
-  if(s != nullptr) m_buffer.reserve(static_cast<std::size_t>(n));
+  if(s != nullptr)
+  {
+    m_size = static_cast<std::size_t>(n);
+    m_buffer.reserve(m_size);
+  }
   return this;
 }
 
@@ -114,17 +190,18 @@ Term::Buffer::int_type Term::Buffer::overflow(int c)
 {
   if(c != std::char_traits<Term::Buffer::char_type>::eof())
   {
+    const char character{static_cast<char>(c)};
     switch(m_type)
     {
       case Type::Unbuffered:
       {
-        Term::Private::out.write(replace(c));
+        write(&character, 1);
         break;
       }
       case Type::LineBuffered:
       {
-        m_buffer += replace(c);
-        if(static_cast<char>(c) == '\n')
+        append(m_buffer, &character, 1);
+        if(character == '\n')
         {
           Term::Private::out.write(m_buffer);
           m_buffer.clear();
@@ -133,12 +210,15 @@ Term::Buffer::int_type Term::Buffer::overflow(int c)
       }
       case Type::FullBuffered:
       {
-        if(m_buffer.size() >= m_buffer.capacity())
+        // Called when the put area is full (or not created yet).
+        if(m_frame) { reserve(m_buffer.size() + 1); }
+        else { flushPutArea(); }
+        if(pptr() == epptr()) { write(&character, 1); }
+        else
         {
-          Term::Private::out.write(m_buffer);
-          m_buffer.clear();
+          *pptr() = character;
+          pbump(1);
         }
-        m_buffer += replace(c);
         break;
       }
     }
@@ -146,6 +226,48 @@ Term::Buffer::int_type Term::Buffer::overflow(int c)
   return c;
 }
 
+std::streamsize Term::Buffer::xsputn(const char_type* s, std::streamsize n)
+{
+  if(n <= 0) return 0;
+  const std::size_t size{static_cast<std::size_t>(n)};
+  switch(m_type)
+  {
+    case Type::Unbuffered:
+    {
+      write(s, size);
+      break;
+    }
+    case Type::LineBuffered:
+    {
+      // Write up to the last new line and keep the rest.
+      const std::reverse_iterator<const char*> last{std::find(std::reverse_iterator<const char*>(s + size), std::reverse_iterator<const char*>(s), '\n')};
+      const std::size_t                        line{static_cast<std::size_t>(last.base() - s)};
+      if(line != 0)
+      {
+        append(m_buffer, s, line);
+        Term::Private::out.write(m_buffer);
+        m_buffer.clear();
+      }
+      append(m_buffer, s + line, size - line);
+      break;
+    }
+    case Type::FullBuffered:
+    {
+      if(m_frame) { reserve(static_cast<std::size_t>(pptr() - pbase()) + size); }
+      else if(pbase() == nullptr || static_cast<std::size_t>(epptr() - pptr()) < size) { flushPutArea(); }
+      if(static_cast<std::size_t>(epptr() - pptr()) < size) { write(s, size); }  // Bigger than the buffer, no need to copy it.
+      else
+      {
+        std::memcpy(pptr(), s, size);
+        pbump(static_cast<int>(n));
+        if(m_interval.count() != 0 && !m_frame && std::chrono::steady_clock::now() - m_last_flush >= m_interval) { flushPutArea(); }
+      }
+      break;
+    }
+  }
+  return n;
+}
+
 Term::Buffer::~Buffer()
 {
   //sync();
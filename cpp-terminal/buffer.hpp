@@ -9,9 +9,11 @@
 
 #pragma once
 
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <streambuf>
+#include <string>
 
 namespace Term
 {
@@ -32,16 +34,46 @@ public:
   Buffer& operator=(Buffer&&)      = delete;
   Buffer& operator=(const Buffer&) = delete;
 
+  ///
+  /// @brief Set when a FullBuffered buffer writes its content to the terminal.
+  ///
+  /// The content is written when \b size bytes are buffered, on flush or, if \b interval is not zero, at the first insertion of a string happening \b interval after the previous write. The first output following an idle period is then written at once while bulk output is grouped in large writes.
+  ///
+  /// @warning \b interval is a minimum time between two writes, not a bound on how long the output stays buffered: nothing is written while the stream is not used. Flush the stream once the output is complete.
+  ///
+  /// @param size : Size of the buffer in bytes.
+  /// @param interval : Minimum time between two writes made by the insertions, \b 0 to only write when the buffer is full.
+  ///
+  void setFlushPolicy(const std::size_t& size, const std::chrono::microseconds& interval = std::chrono::microseconds(0));
+
+  ///
+  /// @brief Start a frame: until endFrame() the buffer grows as needed and nothing is written, not even on flush, so the terminal never displays a partial frame.
+  ///
+  void beginFrame();
+
+  ///
+  /// @brief End the frame started by beginFrame() and write it with a single write.
+  ///
+  void endFrame();
+
 protected:
-  int_type underflow() override;
-  int_type overflow(int c = std::char_traits<Term::Buffer::char_type>::eof()) override;
-  int      sync() override;
+  int_type        underflow() override;
+  int_type        overflow(int c = std::char_traits<Term::Buffer::char_type>::eof()) override;
+  int             sync() override;
+  std::streamsize xsputn(const char_type* s, std::streamsize n) override;
 
 private:
-  void               setType(const Term::Buffer::Type& type);
-  std::streambuf*    setbuf(char* s, std::streamsize n) override;
-  std::string        m_buffer;
-  Term::Buffer::Type m_type{Term::Buffer::Type::LineBuffered};
+  void                                  setType(const Term::Buffer::Type& type);
+  void                                  write(const char* s, const std::size_t& n);
+  void                                  flushPutArea();
+  void                                  reserve(const std::size_t& size);
+  std::streambuf*                       setbuf(char* s, std::streamsize n) override;
+  std::string                           m_buffer;
+  Term::Buffer::Type                    m_type{Term::Buffer::Type::LineBuffered};
+  std::size_t                           m_size{0};
+  std::chrono::microseconds             m_interval{0};
+  std::chrono::steady_clock::time_point m_last_flush;
+  bool                                  m_frame{false};
 };
 
 }  // namespace Term
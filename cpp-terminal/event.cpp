@@ -11,20 +11,111 @@
 
 #include "cpp-terminal/private/conversion.hpp"
 
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <mutex>
 
-#if defined(_MSC_VER)
-  // Disable stupid warnings on Windows
-  #pragma warning(push)
-  #pragma warning(disable : 4582)
-  #pragma warning(disable : 4583)
-#endif
-Term::Event::container::container() {}
+namespace
+{
+// Events keep the time they have been read in 32 bits: milliseconds since this epoch, modulo the period.
+const std::chrono::steady_clock::time_point stamp_epoch{std::chrono::steady_clock::now()};  //NOLINT(fuchsia-statically-constructed-objects,cert-err58-cpp)
+const constexpr std::chrono::milliseconds::rep stamp_period{0xFFFFFFFF};
+}  // namespace
+
+///
+///@brief Reference-counted storage of the \b CopyPaste text.
+///
+///Blocks are recycled through a small free list so pasting does not allocate once the pool is warm, the recycled strings keep their capacity.
+///
+class Term::Event::Payload
+{
+public:
+  Payload(const Payload&)            = delete;
+  Payload(Payload&&)                 = delete;
+  Payload& operator=(const Payload&) = delete;
+  Payload& operator=(Payload&&)      = delete;
+  static Payload* create(const std::string& str);
+  void            acquire() noexcept;
+  void            release() noexcept;
+  bool            shared() const noexcept;
+  std::string&    string() noexcept;
+
+private:
+  Payload()  = default;
+  ~Payload() = default;
+  struct Pool
+  {
+    std::mutex  m_mutex;
+    Payload*    m_free{nullptr};
+    std::size_t m_size{0};
+  };
+  static Pool&                       pool() noexcept;
+  static const constexpr std::size_t m_max_pooled{16};
+  static const constexpr std::size_t m_max_capacity{65536};
+  std::atomic<std::size_t>           m_references{1};
+  std::string                        m_string;
+  Payload*                           m_next{nullptr};
+};
+
+Term::Event::Payload::Pool& Term::Event::Payload::pool() noexcept
+{
+  // Never destroyed: events (e.g. the ones in the static input queue) can be released during static destruction.
+  static Pool* pool{new Pool()};  //NOLINT(cppcoreguidelines-owning-memory)
+  return *pool;
+}
+
+Term::Event::Payload* Term::Event::Payload::create(const std::string& str)
+{
+  Payload* payload{nullptr};
+  {
+    const std::lock_guard<std::mutex> lock(pool().m_mutex);
+    if(pool().m_free != nullptr)
+    {
+      payload       = pool().m_free;
+      pool().m_free = payload->m_next;
+      --pool().m_size;
+    }
+  }
+  if(payload == nullptr) { payload = new Payload(); }  //NOLINT(cppcoreguidelines-owning-memory)
+  payload->m_next = nullptr;
+  payload->m_references.store(1, std::memory_order_relaxed);
+  payload->m_string.assign(str);
+  return payload;
+}
 
-Term::Event::container::~container() {}
-#if defined(_MSC_VER)
-  #pragma warning(pop)
-#endif
+void Term::Event::Payload::acquire() noexcept { m_references.fetch_add(1, std::memory_order_relaxed); }
+
+void Term::Event::Payload::release() noexcept
+{
+  if(m_references.fetch_sub(1, std::memory_order_acq_rel) != 1) return;
+  m_string.clear();
+  if(m_string.capacity() > m_max_capacity) { std::string().swap(m_string); }
+  {
+    const std::lock_guard<std::mutex> lock(pool().m_mutex);
+    if(pool().m_size < m_max_pooled)
+    {
+      m_next        = pool().m_free;
+      pool().m_free = this;
+      ++pool().m_size;
+      return;
+    }
+  }
+  delete this;  //NOLINT(cppcoreguidelines-owning-memory)
+}
+
+bool Term::Event::Payload::shared() const noexcept { return m_references.load(std::memory_order_acquire) != 1; }
+
+std::string& Term::Event::Payload::string() noexcept { return m_string; }
+
+Term::Event::container::container() : m_Key() {}
+
+void Term::Event::release() noexcept
+{
+  if(m_Type == Type::CopyPaste) { m_container.m_payload->release(); }
+  m_Type = Type::Empty;
+}
 
 Term::Key* Term::Event::get_if_key()
 {
@@ -76,13 +167,20 @@ const Term::Cursor* Term::Event::get_if_cursor() const
 
 std::string* Term::Event::get_if_copy_paste()
 {
-  if(m_Type == Type::CopyPaste) return &m_container.m_string;
-  return nullptr;
+  if(m_Type != Type::CopyPaste) return nullptr;
+  // Copy on write: detach from the other events sharing this text before handing out a mutable pointer.
+  if(m_container.m_payload->shared())
+  {
+    Payload* payload{Payload::create(m_container.m_payload->string())};
+    m_container.m_payload->release();
+    m_container.m_payload = payload;
+  }
+  return &m_container.m_payload->string();
 }
 
 const std::string* Term::Event::get_if_copy_paste() const
 {
-  if(m_Type == Type::CopyPaste) return &m_container.m_string;
+  if(m_Type == Type::CopyPaste) return &m_container.m_payload->string();
   return nullptr;
 }
 
@@ -100,77 +198,40 @@ const Term::Focus* Term::Event::get_if_focus() const
   return nullptr;
 }
 
-Term::Event& Term::Event::operator=(const Term::Event& event)
+Term::Event& Term::Event::operator=(const Term::Event& event) noexcept
 {
-  m_Type = event.m_Type;
-  switch(m_Type)
-  {
-    case Type::Empty: break;
-    case Type::Key: m_container.m_Key = event.m_container.m_Key; break;
-    case Type::CopyPaste: new(&this->m_container.m_string) std::string(event.m_container.m_string); break;
-    case Type::Cursor: m_container.m_Cursor = event.m_container.m_Cursor; break;
-    case Type::Screen: m_container.m_Screen = event.m_container.m_Screen; break;
-    case Type::Focus: m_container.m_Focus = event.m_container.m_Focus; break;
-    case Type::Mouse: m_container.m_Mouse = event.m_container.m_Mouse; break;
-    default: break;
-  }
+  if(this == &event) return *this;
+  if(event.m_Type == Type::CopyPaste) { event.m_container.m_payload->acquire(); }
+  release();
+  m_container = event.m_container;
+  m_timestamp = event.m_timestamp;
+  m_repeat    = event.m_repeat;
+  m_Type      = event.m_Type;
   return *this;
 }
 
 Term::Event::Event(const Term::Focus& focus) : m_Type(Type::Focus) { m_container.m_Focus = focus; }
 
-Term::Event::Event(const Term::Event& event)
+Term::Event::Event(const Term::Event& event) noexcept : m_container(event.m_container), m_timestamp(event.m_timestamp), m_repeat(event.m_repeat), m_Type(event.m_Type)
 {
-  m_Type = event.m_Type;
-  switch(m_Type)
-  {
-    case Type::Empty: break;
-    case Type::Key: m_container.m_Key = event.m_container.m_Key; break;
-    case Type::CopyPaste: new(&this->m_container.m_string) std::string(event.m_container.m_string); break;
-    case Type::Cursor: m_container.m_Cursor = event.m_container.m_Cursor; break;
-    case Type::Screen: m_container.m_Screen = event.m_container.m_Screen; break;
-    case Type::Focus: m_container.m_Focus = event.m_container.m_Focus; break;
-    case Type::Mouse: m_container.m_Mouse = event.m_container.m_Mouse; break;
-    default: break;
-  }
+  if(m_Type == Type::CopyPaste) { m_container.m_payload->acquire(); }
 }
 
-Term::Event::~Event()
-{
-  using std::string;
-  if(m_Type == Type::CopyPaste) { m_container.m_string.~string(); }
-}
+Term::Event::~Event() { release(); }
 
 Term::Event::Event() = default;
 
-Term::Event::Event(Term::Event&& event) noexcept : m_Type(event.m_Type)
-{
-  switch(m_Type)
-  {
-    case Type::Empty: break;
-    case Type::Key: std::swap(m_container.m_Key, event.m_container.m_Key); break;
-    case Type::CopyPaste: std::swap(m_container.m_string, event.m_container.m_string); break;
-    case Type::Cursor: std::swap(m_container.m_Cursor, event.m_container.m_Cursor); break;
-    case Type::Screen: std::swap(m_container.m_Screen, event.m_container.m_Screen); break;
-    case Type::Focus: std::swap(m_container.m_Focus, event.m_container.m_Focus); break;
-    case Type::Mouse: std::swap(m_container.m_Mouse, event.m_container.m_Mouse); break;
-    default: break;
-  }
-}
+Term::Event::Event(Term::Event&& event) noexcept : m_container(event.m_container), m_timestamp(event.m_timestamp), m_repeat(event.m_repeat), m_Type(event.m_Type) { event.m_Type = Type::Empty; }
 
 Term::Event& Term::Event::operator=(Term::Event&& other) noexcept
 {
-  switch(other.m_Type)
-  {
-    case Type::Empty: break;
-    case Type::Key: std::swap(m_container.m_Key, other.m_container.m_Key); break;
-    case Type::CopyPaste: std::swap(m_container.m_string, other.m_container.m_string); break;
-    case Type::Cursor: std::swap(m_container.m_Cursor, other.m_container.m_Cursor); break;
-    case Type::Screen: std::swap(m_container.m_Screen, other.m_container.m_Screen); break;
-    case Type::Focus: std::swap(m_container.m_Focus, other.m_container.m_Focus); break;
-    case Type::Mouse: std::swap(m_container.m_Mouse, other.m_container.m_Mouse); break;
-    default: break;
-  }
+  if(this == &other) return *this;
+  release();
+  m_container  = other.m_container;
+  m_timestamp  = other.m_timestamp;
+  m_repeat     = other.m_repeat;
+  m_Type       = other.m_Type;
+  other.m_Type = Type::Empty;
   return *this;
 }
 
@@ -186,7 +247,7 @@ Term::Event::operator Term::Mouse() const
 
 Term::Event::operator std::string() const
 {
-  if(m_Type == Type::CopyPaste) { return m_container.m_string; }
+  if(m_Type == Type::CopyPaste) { return m_container.m_payload->string(); }
   return {};
 }
 
@@ -202,6 +263,24 @@ Term::Event::Event(const Term::Key& key) : m_Type(Type::Key) { m_container.m_Key
 
 Term::Event::Type Term::Event::type() const { return m_Type; }
 
+std::chrono::steady_clock::time_point Term::Event::timestamp() const noexcept
+{
+  if(m_timestamp == 0) return {};
+  // Only 32 bits are stored, take the last time matching the stamp.
+  const std::chrono::milliseconds::rep elapsed{std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - stamp_epoch).count()};
+  std::chrono::milliseconds::rep       stamp{elapsed - elapsed % stamp_period + m_timestamp - 1};
+  if(stamp > elapsed) { stamp -= stamp_period; }
+  return stamp_epoch + std::chrono::milliseconds(stamp);
+}
+
+void Term::Event::stamp(const std::chrono::steady_clock::time_point& time) noexcept
+{
+  const std::chrono::milliseconds::rep elapsed{std::chrono::duration_cast<std::chrono::milliseconds>(time - stamp_epoch).count()};
+  m_timestamp = static_cast<std::uint32_t>(std::max<std::chrono::milliseconds::rep>(elapsed, 0) % stamp_period + 1);
+}
+
+std::uint32_t Term::Event::repeat() const noexcept { return m_repeat; }
+
 Term::Event::Event(const std::string& str) { parse(str); }
 
 void Term::Event::parse(const std::string& str)
@@ -240,24 +319,26 @@ void Term::Event::parse(const std::string& str)
   }
   else if(str[0] == '\033' && str[1] == '[' && str[2] == '<')
   {
-    static std::chrono::time_point<std::chrono::system_clock> old;
-    bool                                                      not_too_long{false};
-    if(std::chrono::system_clock::now() - old <= std::chrono::milliseconds{120}) not_too_long = true;
-    m_Type = Type::Mouse;
-    std::size_t              pos{3};
-    std::size_t              pos2{3};
-    std::vector<std::size_t> values;
-    while((pos = str.find(';', pos)) != std::string::npos)
+    // SGR report \033[<button;x;y(M|m) parsed in place.
+    std::array<std::uint32_t, 3> values{{0, 0, 0}};
+    std::size_t                  field{0};
+    char                         terminator{str[str.size() - 1]};
+    for(std::size_t i = 3; i < str.size() && field != values.size(); ++i)
     {
-      values.push_back(std::stoull(str.substr(pos2, pos - pos2)));
-      pos++;
-      pos2 = pos;
+      if(str[i] == ';') { ++field; }
+      else if(str[i] >= '0' && str[i] <= '9')
+      {
+        if(values[field] <= 0xFFFF) { values[field] = values[field] * 10 + static_cast<std::uint32_t>(str[i] - '0'); }
+      }
+      else
+      {
+        // End of this report, a read can return several of them.
+        terminator = str[i];
+        break;
+      }
     }
-    values.push_back(std::stoull(str.substr(pos2, str.size() - pos2 - 1)));
-    static Term::Mouse   first;
-    static Term::Mouse   second;
     Term::Button::Action action;
-    if(str[str.size() - 1] == 'm') action = Term::Button::Action::Released;
+    if(terminator == 'm') action = Term::Button::Action::Released;
     else
       action = Term::Button::Action::Pressed;
     Term::Button::Type type = Button::Type::None;
@@ -298,11 +379,8 @@ void Term::Event::parse(const std::string& str)
       }
       default: break;
     }
-    if(not_too_long && first.row() == second.row() && second.row() == values[1] && first.column() == second.column() && second.column() == values[2] && first.getButton().type() == second.getButton().type() && second.getButton().type() == type && first.getButton().action() == Button::Action::Released && second.getButton().action() == Button::Action::Pressed && action == Button::Action::Pressed) action = Term::Button::Action::DoubleClicked;
-    second              = first;
-    first               = Term::Mouse(Term::Button(type, action), values[1], values[2]);
-    m_container.m_Mouse = first;
-    old                 = std::chrono::system_clock::now();
+    m_container.m_Mouse = Term::Mouse(Term::Button(type, action), static_cast<std::uint16_t>(std::min<std::uint32_t>(values[1], 0xFFFF)), static_cast<std::uint16_t>(std::min<std::uint32_t>(values[2], 0xFFFF)));
+    m_Type              = Type::Mouse;
   }
   else if(str.size() <= 10)
   {
@@ -436,16 +514,16 @@ void Term::Event::parse(const std::string& str)
       m_container.m_Key = Key(static_cast<Term::Key::Value>(Term::Private::utf8_to_utf32(str)[0]));
     else
     {
-      m_Type = Type::CopyPaste;
-      new(&this->m_container.m_string) std::string(str);
+      m_container.m_payload = Payload::create(str);
+      m_Type                = Type::CopyPaste;
       return;
     }
     m_Type = Type::Key;
   }
   else
   {
-    m_Type = Type::CopyPaste;
-    new(&this->m_container.m_string) std::string(str);
+    m_container.m_payload = Payload::create(str);
+    m_Type                = Type::CopyPaste;
   }
 }
 
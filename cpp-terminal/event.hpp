@@ -15,16 +15,30 @@
 #include "cpp-terminal/mouse.hpp"
 #include "cpp-terminal/screen.hpp"
 
+#include <chrono>
 #include <cstdint>
 #include <string>
 
 namespace Term
 {
 
+namespace Private
+{
+class BlockingQueue;
+class Input;
+}  // namespace Private
+
+///
+/// @brief Input event read from the terminal.
+///
+/// Events are kept small and trivially movable so they can travel through the input queue without heap traffic: every payload except \b CopyPaste is stored inline, and the \b CopyPaste text lives in a reference-counted block recycled through a pool. Copying an event shares the text, which is only duplicated when it is modified through the non-const get_if_copy_paste().
+///
 class Event
 {
 public:
-  enum class Type
+  friend class Private::BlockingQueue;
+  friend class Private::Input;
+  enum class Type : std::uint8_t
   {
     Empty,
     Key,
@@ -42,12 +56,26 @@ public:
   Event(const Term::Cursor& cursor);
   Event(const Term::Focus& focus);
   Event(const Term::Mouse& mouse);
-  Event(const Term::Event& event);
+  Event(const Term::Event& event) noexcept;
   Event(Term::Event&& event) noexcept;
   Event& operator=(Event&& other) noexcept;
-  Event& operator=(const Term::Event& event);
+  Event& operator=(const Term::Event& event) noexcept;
   bool   empty() const;
   Type   type() const;
+
+  ///
+  /// @brief Time at which the bytes of the event have been read from the terminal (\b steady_clock).
+  ///
+  /// Allows to measure the time spent by the event in the queue or the input-to-screen latency, with a millisecond resolution. Events not read from the terminal have a default constructed (epoch) timestamp.
+  ///
+  std::chrono::steady_clock::time_point timestamp() const noexcept;
+
+  ///
+  /// @brief Number of times the event occurred in a row, at least 1.
+  ///
+  /// Only greater than 1 when key repeats are coalesced (see Term::coalesce_key_repeat()), "ArrowDown x40" is then read as a single event.
+  ///
+  std::uint32_t repeat() const noexcept;
   operator Term::Key() const;
   operator Term::Screen() const;
   operator Term::Cursor() const;
@@ -70,24 +98,29 @@ public:
   const std::string* get_if_copy_paste() const;
 
 private:
+  class Payload;
   void parse(const std::string& str);
+  void release() noexcept;
+  void stamp(const std::chrono::steady_clock::time_point& time) noexcept;
   union container
   {
     container();
-    ~container();
-    container(const container&)              = delete;
-    container(container&&)                   = delete;
-    container&   operator=(const container&) = delete;
-    container&   operator=(container&&)      = delete;
-    Term::Key    m_Key;
-    Term::Cursor m_Cursor;
-    Term::Screen m_Screen;
-    Term::Focus  m_Focus;
-    Term::Mouse  m_Mouse;
-    std::string  m_string;
+    ~container()                                      = default;
+    container(const container&)                       = default;
+    container(container&&)                            = default;
+    container&            operator=(const container&) = default;
+    container&            operator=(container&&)      = default;
+    Term::Key             m_Key;
+    Term::Cursor          m_Cursor;
+    Term::Screen          m_Screen;
+    Term::Focus           m_Focus;
+    Term::Mouse           m_Mouse;
+    Term::Event::Payload* m_payload;
   };
-  Type      m_Type{Type::Empty};
-  container m_container;
+  container     m_container;
+  std::uint32_t m_timestamp{0};  // milliseconds since the library has been loaded plus one (0 if not read), wraps after 49 days
+  std::uint16_t m_repeat{1};
+  Type          m_Type{Type::Empty};
 };
 
 }  // namespace Term
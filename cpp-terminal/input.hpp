@@ -11,9 +11,149 @@
 
 #include "cpp-terminal/event.hpp"
 
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
 namespace Term
 {
 
+///
+/// @brief How the terminal input is read.
+///
+enum class InputMode : std::uint8_t
+{
+  Thread,      ///< A background thread reads the input and queues the events (default).
+  Threadless,  ///< No thread, the input is read and parsed on the caller's thread by poll_input() and the read_event functions.
+};
+
+///
+/// @brief What to do with the events read while the event queue is full.
+///
+enum class OverflowPolicy : std::uint8_t
+{
+  DropOldestMotion,  ///< Drop the oldest mouse motion event waiting to be read, or the new event if there is none (default).
+  DropNewest,        ///< Drop the new event.
+  Block,             ///< Stop reading the input until the application reads an event. Behaves as DropNewest in Term::InputMode::Threadless.
+};
+
+///
+/// @brief Select how the terminal input is read, must be called before the first read.
+///
+/// In Term::InputMode::Threadless the input is only read when the application calls poll_input(), read_event(), read_event_for(), try_read_event() or read_events(), which suits single-threaded servers and deterministic tests. Only one thread should read the events in this mode.
+///
+/// @throw Term::Exception if the input is already being read in another mode.
+///
+void set_input_mode(const Term::InputMode& mode);
+
+///
+/// @brief Wait up to \b timeout for input.
+///
+/// In Term::InputMode::Threadless the input is read and parsed on the caller's thread; in Term::InputMode::Thread this only waits for the reading thread to queue events.
+///
+/// @param timeout : Maximum time to wait, \b zero to not wait and std::chrono::milliseconds::max() to wait forever.
+/// @return The number of events waiting to be read.
+///
+std::size_t poll_input(const std::chrono::milliseconds& timeout);
+
+///
+/// @brief Stop reading the terminal input and join the reading thread.
+///
+/// The events already queued are kept and the next read starts reading again, so the terminal can be torn down and set up again in the same process. The input mode can be changed in between.
+///
+void stop_reading();
+
 Term::Event read_event();
 
+///
+/// @brief Read an event if one is available, without waiting.
+///
+/// @return The event, or an empty event if none is pending.
+///
+Term::Event try_read_event();
+
+///
+/// @brief Wait up to \b timeout for an event.
+///
+/// Several threads can wait at the same time, each event is delivered to only one of them. Allows an idle application to wake up regularly (to redraw a clock, a progress bar...) without an extra thread.
+///
+/// @return The event, or an empty event if none arrived in time.
+///
+Term::Event read_event_for(const std::chrono::milliseconds& timeout);
+
+///
+/// @brief Read all the pending events at once.
+///
+/// Wait up to \b timeout for an event then move up to \b max available events at the end of \b events, taking the event queue lock only once. The storage is owned by the caller so its capacity can be reused from one frame to the next.
+///
+/// @param events : Container receiving the events.
+/// @param max : Maximum number of events to read.
+/// @param timeout : Maximum time to wait for the first event, \b zero to not wait and std::chrono::milliseconds::max() to wait forever.
+/// @return The number of events added to \b events.
+///
+std::size_t read_events(std::vector<Term::Event>& events, const std::size_t& max = std::numeric_limits<std::size_t>::max(), const std::chrono::milliseconds& timeout = std::chrono::milliseconds::max());
+
+///
+/// @brief Get a file descriptor readable whenever events are waiting to be read.
+///
+/// Add it to an external event loop (epoll, libuv, asio...) next to other sources and call try_read_event() or read_events() when it becomes readable. The descriptor is owned by cpp-terminal and must not be read or closed. Starts reading the terminal input.
+///
+/// In Term::InputMode::Threadless nothing queues the events in the background: the descriptor is then readable when the terminal has input to parse (or, on Linux, has been resized) and the events are only queued by the read call. The events left in the queue don't keep it readable so read them all with read_events(); a debounced resize is only queued by a read call made after the delay.
+///
+/// @return The file descriptor, -1 on Windows where it is not available.
+///
+std::int32_t event_queue_fd();
+
+///
+/// @brief Coalesce consecutive mouse motion events.
+///
+/// With any-event mouse tracking every mouse move generates an event. When activated, a motion event (Term::Button::Action::None) with the same button state as the last event still waiting to be read replaces it, so only the newest position is delivered. Disabled by default.
+///
+/// @param coalesce : \b true to coalesce the motion events, \b false to deliver each of them.
+///
+void coalesce_mouse_motion(const bool& coalesce);
+
+///
+/// @brief Deliver key repeats as a single event.
+///
+/// Identical consecutive keys are always stored once in the queue with a repeat count. By default they are still read one by one, when activated they are read as one event whose Term::Event::repeat() gives the count, so holding a key on a slow machine doesn't make list views overshoot.
+///
+/// @param coalesce : \b true to read the repeats as one event, \b false to read each of them.
+///
+void coalesce_key_repeat(const bool& coalesce);
+
+///
+/// @brief Wait for the terminal size to be stable for \b debounce before reporting a resize (0 by default).
+///
+/// Dragging a window edge resizes the terminal many times; with a debounce delay a single Term::Screen event with the final size is queued once no resize happened for \b debounce. Term::screen_size() stays up to date in between.
+///
+void set_resize_debounce(const std::chrono::milliseconds& debounce);
+
+///
+/// @brief Bound the number of events waiting to be read so the memory stays bounded when the application stalls.
+///
+/// Resize and focus events, and the repeats of a key, don't count. The queue is unbounded by default.
+///
+/// @param capacity : Maximum number of events waiting to be read, \b 0 for unbounded.
+/// @param policy : What to do with the events read while the queue is full.
+///
+void set_event_queue_capacity(const std::size_t& capacity, const Term::OverflowPolicy& policy = Term::OverflowPolicy::DropOldestMotion);
+
+///
+/// @brief Number of events lost because the event queue was full.
+///
+std::size_t event_queue_overflows();
+
+///
+/// @brief Number of times the reading waited for the application to make room with Term::OverflowPolicy::Block (back-pressure, no event is lost).
+///
+std::size_t event_queue_waits();
+
+///
+/// @brief Set the maximum delay between the release of a mouse click and the next press for this press to be reported as Term::Button::Action::DoubleClicked (120 ms by default).
+///
+void set_double_click_interval(const std::chrono::milliseconds& interval);
+
 }  // namespace Term
@@ -0,0 +1,144 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Term
+{
+
+///
+/// @brief How the library writes to the terminal.
+///
+enum class OutputMode : std::uint8_t
+{
+  Blocking,     ///< The writes block until the terminal accepts the data (default).
+  NonBlocking,  ///< The writes never block in the kernel, the library waits on \b poll for the terminal to accept the rest of the data.
+};
+
+///
+/// @brief Statistics about the writes to the terminal.
+///
+struct OutputStats
+{
+  std::uint64_t            bytes{0};            ///< Bytes written to the terminal.
+  std::uint64_t            writes{0};           ///< Calls to \b write / \b writev (\b WriteConsole on Windows).
+  std::uint64_t            short_writes{0};     ///< Calls that wrote only a part of the data.
+  std::uint64_t            would_block{0};      ///< Calls that failed with \b EAGAIN (non-blocking mode).
+  std::chrono::nanoseconds blocked{0};          ///< Time spent writing and waiting for the terminal to accept the data.
+  std::uint64_t            replaced_frames{0};  ///< Frames replaced by a newer one before being written (submit_frame()).
+};
+
+///
+/// @brief Statistics about the writes to the terminal since the start of the program or the last reset_output_stats().
+///
+/// The writes from the background writer (set_async_output()) are included. Take a snapshot before and after drawing a screen to know the volume it costs.
+///
+Term::OutputStats output_stats();
+
+///
+/// @brief Reset the statistics returned by output_stats().
+///
+void reset_output_stats();
+
+///
+/// @brief How far the terminal is behind the output.
+///
+struct OutputBacklog
+{
+  std::size_t queued{0};      ///< Bytes written but still in the output queue of the tty (\b TIOCOUTQ) or, on Linux, of the socket (\b SIOCOUTQ, same request), always 0 where not supported (Windows).
+  std::size_t pending{0};     ///< Bytes handed to the background writer (set_async_output()) and not written yet.
+  double      drain_rate{0};  ///< Estimated bytes per second the terminal consumes, 0 until it has been estimated.
+  ///
+  /// @brief Estimated time to display the output already produced, 0 if unknown.
+  ///
+  std::chrono::milliseconds delay() const noexcept { return drain_rate > 0 ? std::chrono::milliseconds(static_cast<std::int64_t>(static_cast<double>(queued + pending) * 1000.0 / drain_rate)) : std::chrono::milliseconds(0); }
+};
+
+///
+/// @brief How far the terminal is behind the output, to skip frames or lower the detail while it catches up.
+///
+/// The drain rate is estimated while the terminal is behind: from the bytes leaving the tty queue between two calls when it stays non empty, otherwise from the bytes and the duration of the writes that had to wait for the terminal. Call it once per frame. On Linux the queue of a pty (ssh, terminal emulators...) is always reported empty, only the second estimate is available there.
+///
+Term::OutputBacklog output_backlog();
+
+///
+/// @brief Record the session in the asciicast v2 file \b path (created or truncated), it can be replayed with asciinema.
+///
+/// Everything written to the terminal by the library is appended with its timestamp, and so are the resizes seen by the events. The writing thread only timestamps and queues the data, the file is written by a background thread.
+///
+void start_recording(const std::string& path);
+
+///
+/// @brief Stop the recording started by start_recording() and close the file.
+///
+void stop_recording();
+
+///
+/// @brief Switch the terminal output between blocking and non-blocking writes.
+///
+/// In both modes the writes are complete: a short write is continued until all the data is written. In non-blocking mode a write waiting longer than \b timeout for the terminal (suspended with Ctrl+S, dead ssh link...) throws a Term::Exception instead of hanging forever. Only the library's own file descriptor is affected, not the one of std::cout. No-op on Windows.
+///
+/// @param mode : The output mode.
+/// @param timeout : How long a non-blocking write waits for the terminal before giving up.
+///
+void set_output_mode(const Term::OutputMode& mode, const std::chrono::milliseconds& timeout = std::chrono::milliseconds(5000));
+
+///
+/// @brief Write the terminal output from a background thread.
+///
+/// When activated, the output (Term::cout flushes...) is handed to a writer thread and the caller continues at once, a slow terminal (congested ssh link...) doesn't block the rendering anymore. The writes keep their order. Deactivating it waits for the pending output to be written. Switch it while no other thread writes to the terminal.
+///
+/// @param async : \b true to write from a background thread, \b false to write from the caller's thread (default).
+///
+void set_async_output(const bool& async);
+
+///
+/// @brief Wait until the output handed to the background writer has reached the terminal, returns at once if the output is synchronous.
+///
+void flush_output();
+
+///
+/// @brief Write a complete frame (a full redraw or a diff against the frame last_committed_frame()).
+///
+/// With set_async_output(true), a frame still waiting to be written is replaced by the new one: when the terminal is slower than the frames are produced the frame rate degrades instead of stale frames piling up. A frame made as a diff must then be computed against last_committed_frame(), not against the previous frame submitted. Without asynchronous output the frame is written at once.
+///
+/// @param base : Id of the frame \b frame is a diff against, 0 for a full redraw. The background writer can commit another frame between last_committed_frame() and this call: \b base is checked against the committed frame atomically.
+/// @return The id of the frame, ids are increasing and start at 1. 0 if \b base isn't the committed frame anymore: the frame is dropped, compute it again against last_committed_frame().
+///
+std::uint64_t submit_frame(std::string frame, const std::uint64_t& base = 0);
+
+///
+/// @brief Id of the last frame the background writer has started to write, 0 if none.
+///
+/// This frame can't be replaced anymore and the frames submitted afterwards reach the terminal after it: diff the next frame against it. It is ahead of last_written_frame() while the frame is being written.
+///
+std::uint64_t last_committed_frame();
+
+///
+/// @brief Id of the last frame completely written to the terminal, 0 if none.
+///
+std::uint64_t last_written_frame();
+
+///
+/// @brief Write several buffers in order (cached static parts, dynamic regions...) with a single system call, without concatenating them first.
+///
+/// The buffers are written directly, flush Term::cout before if it has been used.
+///
+/// @return The number of bytes written.
+///
+std::size_t write_output(const std::vector<std::reference_wrapper<const std::string>>& buffers);
+
+}  // namespace Term
@@ -9,44 +9,265 @@
 
 #include "cpp-terminal/private/blocking_queue.hpp"
 
+#include <algorithm>
+#include <limits>
+
+namespace
+{
+bool is_motion(const Term::Event& event)
+{
+  const Term::Mouse* mouse{event.get_if_mouse()};
+  return mouse != nullptr && mouse->getButton().action() == Term::Button::Action::None;
+}
+
+bool is_priority(const Term::Event& event) { return event.type() == Term::Event::Type::Screen || event.type() == Term::Event::Type::Focus; }
+}  // namespace
+
+Term::Private::BlockingQueue::BlockingQueue() : m_ring(64) { m_priority.reserve(2); }
+
+void Term::Private::BlockingQueue::push_priority(Term::Event&& value)
+{
+  for(Term::Event& event: m_priority)
+  {
+    if(event.type() == value.type())
+    {
+      event = std::move(value);
+      return;
+    }
+  }
+  if(m_count == 0 && m_ready) { m_ready->signal(); }
+  m_priority.push_back(std::move(value));
+  ++m_count;
+}
+
+void Term::Private::BlockingQueue::push_back(Term::Event&& value)
+{
+  if(m_size == m_ring.size())
+  {
+    std::vector<Term::Event> ring(2 * m_ring.size());
+    for(std::size_t i = 0; i != m_size; ++i) { ring[i] = std::move(m_ring[(m_head + i) & (m_ring.size() - 1)]); }
+    m_ring.swap(ring);
+    m_head = 0;
+  }
+  if(m_count == 0 && m_ready) { m_ready->signal(); }
+  m_count += value.m_repeat;
+  m_ring[(m_head + m_size) & (m_ring.size() - 1)] = std::move(value);
+  ++m_size;
+}
+
+Term::Event Term::Private::BlockingQueue::pop_front()
+{
+  if(!m_priority.empty())
+  {
+    Term::Event value{std::move(m_priority.front())};
+    m_priority.erase(m_priority.begin());
+    if(--m_count == 0 && m_ready) { m_ready->clear(); }
+    return value;
+  }
+  Term::Event& front{m_ring[m_head]};
+  if(!m_coalesce_repeat && front.m_repeat > 1)
+  {
+    --front.m_repeat;
+    --m_count;
+    Term::Event value{front};
+    value.m_repeat = 1;
+    return value;
+  }
+  m_count -= front.m_repeat;
+  Term::Event value{std::move(front)};
+  m_head = (m_head + 1) & (m_ring.size() - 1);
+  --m_size;
+  if(m_count == 0 && m_ready) { m_ready->clear(); }
+  if(m_blocked != 0) { m_not_full.notify_all(); }
+  return value;
+}
+
+bool Term::Private::BlockingQueue::make_room(std::unique_lock<std::mutex>& lock)
+{
+  if(m_capacity == 0 || m_size < m_capacity) return true;
+  switch(m_policy)
+  {
+    case Term::OverflowPolicy::Block:
+    {
+      if(!m_interrupted)
+      {
+        ++m_waits;
+        ++m_blocked;
+        m_not_full.wait(lock, [this]() { return m_capacity == 0 || m_size < m_capacity || m_interrupted; });
+        --m_blocked;
+        if(m_capacity == 0 || m_size < m_capacity) return true;
+      }
+      // Interrupted, the event is lost.
+      ++m_overflows;
+      return false;
+    }
+    case Term::OverflowPolicy::DropOldestMotion:
+    {
+      for(std::size_t i = 0; i != m_size; ++i)
+      {
+        if(!is_motion(m_ring[(m_head + i) & (m_ring.size() - 1)])) continue;
+        m_count -= m_ring[(m_head + i) & (m_ring.size() - 1)].m_repeat;
+        for(std::size_t j = i; j + 1 != m_size; ++j) { m_ring[(m_head + j) & (m_ring.size() - 1)] = std::move(m_ring[(m_head + j + 1) & (m_ring.size() - 1)]); }
+        --m_size;
+        ++m_overflows;
+        return true;
+      }
+      // No motion to drop, drop the newest.
+      ++m_overflows;
+      return false;
+    }
+    case Term::OverflowPolicy::DropNewest:
+    {
+      ++m_overflows;
+      return false;
+    }
+  }
+  return false;
+}
+
+Term::Event& Term::Private::BlockingQueue::back() { return m_ring[(m_head + m_size - 1) & (m_ring.size() - 1)]; }
+
+void Term::Private::BlockingQueue::notify()
+{
+  if(m_waiting != 0) { m_cv.notify_all(); }
+}
+
 Term::Event Term::Private::BlockingQueue::pop()
 {
   const std::lock_guard<std::mutex> lock(m_mutex);
-  Term::Event                       value = this->m_queue.front();
-  m_queue.pop();
-  return value;
+  if(m_count == 0) return {};
+  return pop_front();
+}
+
+bool Term::Private::BlockingQueue::coalesce(const Term::Event& value)
+{
+  if(!m_coalesce_motion || m_size == 0 || !is_motion(value) || !is_motion(back())) return false;
+  if(back().get_if_mouse()->getButton().type() != value.get_if_mouse()->getButton().type()) return false;
+  back() = value;
+  return true;
+}
+
+bool Term::Private::BlockingQueue::repeat(const Term::Event& value, const std::size_t& occurrence)
+{
+  if(m_size == 0 || value.get_if_key() == nullptr || back().get_if_key() == nullptr || *back().get_if_key() != *value.get_if_key()) return false;
+  if(occurrence > static_cast<std::size_t>(std::numeric_limits<std::uint16_t>::max() - back().m_repeat)) return false;
+  back().m_repeat = static_cast<std::uint16_t>(back().m_repeat + occurrence);
+  m_count += occurrence;
+  return true;
+}
+
+bool Term::Private::BlockingQueue::wait(std::unique_lock<std::mutex>& lock, const std::chrono::milliseconds& timeout)
+{
+  if(m_count != 0 || timeout <= std::chrono::milliseconds::zero()) return m_count != 0;
+  ++m_waiting;
+  if(timeout == std::chrono::milliseconds::max()) { m_cv.wait(lock, [this]() { return m_count != 0; }); }
+  else { m_cv.wait_for(lock, timeout, [this]() { return m_count != 0; }); }
+  --m_waiting;
+  return m_count != 0;
+}
+
+Term::Event Term::Private::BlockingQueue::pop(const std::chrono::milliseconds& timeout)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if(!wait(lock, timeout)) return {};
+  return pop_front();
 }
 
-void Term::Private::BlockingQueue::push(const Term::Event& value, const std::size_t& occurrence)
+std::size_t Term::Private::BlockingQueue::pop(std::vector<Term::Event>& values, const std::size_t& max, const std::chrono::milliseconds& timeout)
 {
-  for(std::size_t i = 0; i != occurrence; ++i)
+  std::unique_lock<std::mutex> lock(m_mutex);
+  wait(lock, timeout);
+  std::size_t popped{0};
+  while(popped != max && m_count != 0)
   {
-    const std::lock_guard<std::mutex> lock(m_mutex);
-    m_queue.push(value);
-    m_cv.notify_all();
+    values.push_back(pop_front());
+    ++popped;
   }
+  return popped;
 }
 
-void Term::Private::BlockingQueue::push(const Term::Event&& value, const std::size_t& occurrence)
+void Term::Private::BlockingQueue::push(const Term::Event& value, const std::size_t& occurrence) { push(Term::Event(value), occurrence); }
+
+void Term::Private::BlockingQueue::push(Term::Event&& value, const std::size_t& occurrence)
 {
-  for(std::size_t i = 0; i != occurrence; ++i)
+  if(occurrence == 0) return;
+  std::unique_lock<std::mutex> lock(m_mutex);
+  if(coalesce(value) || repeat(value, occurrence)) return;
+  if(is_priority(value))
   {
-    const std::lock_guard<std::mutex> lock(m_mutex);
-    m_queue.push(value);
-    m_cv.notify_all();
+    push_priority(std::move(value));
+    return notify();
   }
+  if(!make_room(lock)) return;
+  value.m_repeat = static_cast<std::uint16_t>(std::min<std::size_t>(occurrence, std::numeric_limits<std::uint16_t>::max()));
+  push_back(std::move(value));
+  notify();
 }
 
 bool Term::Private::BlockingQueue::empty()
 {
   const std::lock_guard<std::mutex> lock(m_mutex);
-  return m_queue.empty();
+  return m_count == 0;
 }
 
 std::size_t Term::Private::BlockingQueue::size()
 {
   const std::lock_guard<std::mutex> lock(m_mutex);
-  return m_queue.size();
+  return m_coalesce_repeat ? m_priority.size() + m_size : m_count;
+}
+
+bool Term::Private::BlockingQueue::wait_for_events(const std::chrono::milliseconds& timeout)
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  return wait(lock, timeout);
+}
+
+void Term::Private::BlockingQueue::set_motion_coalescing(const bool& coalesce)
+{
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  m_coalesce_motion = coalesce;
+}
+
+void Term::Private::BlockingQueue::set_repeat_coalescing(const bool& coalesce)
+{
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  m_coalesce_repeat = coalesce;
+}
+
+void Term::Private::BlockingQueue::set_capacity(const std::size_t& capacity, const Term::OverflowPolicy& policy)
+{
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  m_capacity = capacity;
+  m_policy   = policy;
+  if(m_blocked != 0) { m_not_full.notify_all(); }
+}
+
+std::size_t Term::Private::BlockingQueue::overflows()
+{
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  return m_overflows;
+}
+
+std::size_t Term::Private::BlockingQueue::waits()
+{
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  return m_waits;
+}
+
+void Term::Private::BlockingQueue::interrupt(const bool& interrupt)
+{
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  m_interrupted = interrupt;
+  if(m_blocked != 0) { m_not_full.notify_all(); }
 }
 
-void Term::Private::BlockingQueue::wait_for_events(std::unique_lock<std::mutex>& lock) { m_cv.wait(lock); }
+std::int32_t Term::Private::BlockingQueue::ready_fd()
+{
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  if(!m_ready)
+  {
+    m_ready.reset(new EventFd());  //NOLINT(cppcoreguidelines-owning-memory)
+    if(m_count != 0) { m_ready->signal(); }
+  }
+  return m_ready->fd();
+}
@@ -10,10 +10,16 @@
 #pragma once
 
 #include "cpp-terminal/event.hpp"
+#include "cpp-terminal/input.hpp"
+#include "cpp-terminal/private/event_fd.hpp"
 
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <vector>
 
 namespace Term
 {
@@ -21,26 +27,128 @@ namespace Term
 namespace Private
 {
 
+///
+///@brief Queue of the events read from the terminal.
+///
+///Events are stored in a ring buffer growing by powers of two so queueing does not allocate once the ring has reached its working size. Consumers are only notified when one of them is actually waiting, the push of an event read while the application is busy costs no system call.
+///
+///Screen and Focus events go through a priority lane read before the other events, so a resize isn't delayed by a backlog of keystrokes. The lane keeps only the latest event of each type: a window drag generating many resizes results in a single Screen event with the final size.
+///
+///The ring is unbounded by default, set_capacity() bounds it and chooses what happens to the events pushed while it is full.
+///
+///Identical consecutive keys share one entry holding a repeat count (see Term::Event::repeat()), holding a key on a slow machine doesn't flood the queue. Unless set_repeat_coalescing() is activated, the entry is expanded lazily and popped as that many events.
+///
 class BlockingQueue
 {
 public:
   ~BlockingQueue()                                     = default;
-  BlockingQueue()                                      = default;
+  BlockingQueue();
   BlockingQueue(const BlockingQueue& other)            = delete;
   BlockingQueue(BlockingQueue&& other)                 = delete;
   BlockingQueue& operator=(const BlockingQueue& other) = delete;
   BlockingQueue& operator=(BlockingQueue&& other)      = delete;
   Term::Event    pop();
+
+  ///
+  ///@brief Wait up to \b timeout for an event (forever for std::chrono::milliseconds::max()) and take it.
+  ///
+  ///@return The event, or an empty event if none arrived in time.
+  ///
+  Term::Event    pop(const std::chrono::milliseconds& timeout);
+
+  ///
+  ///@brief Move up to \b max events at the end of \b values under a single lock.
+  ///
+  ///Wait up to \b timeout for the first event (forever for std::chrono::milliseconds::max()), then take the ones available without waiting anymore.
+  ///
+  ///@return The number of events added to \b values.
+  ///
+  std::size_t    pop(std::vector<Term::Event>& values, const std::size_t& max, const std::chrono::milliseconds& timeout);
   void           push(const Term::Event& value, const std::size_t& occurrence = 1);
-  void           push(const Term::Event&& value, const std::size_t& occurrence = 1);
+  void           push(Term::Event&& value, const std::size_t& occurrence = 1);
   bool           empty();
+
+  ///
+  ///@brief Number of events that can be popped, a key repeat entry counts for its repeat count unless set_repeat_coalescing() is activated.
+  ///
   std::size_t    size();
-  void           wait_for_events(std::unique_lock<std::mutex>& lock);
+
+  ///
+  ///@brief Wait up to \b timeout for the queue to contain events (forever for std::chrono::milliseconds::max()).
+  ///
+  ///@return \b true if events are available.
+  ///
+  bool           wait_for_events(const std::chrono::milliseconds& timeout);
+
+  ///
+  ///@brief Coalesce consecutive mouse motion events.
+  ///
+  ///When activated, a motion event replaces the last queued event if it is a motion event with the same button, only the newest position is kept.
+  ///
+  void set_motion_coalescing(const bool& coalesce);
+
+  ///
+  ///@brief Pop key repeats as a single event carrying the repeat count instead of expanding them.
+  ///
+  void set_repeat_coalescing(const bool& coalesce);
+
+  ///
+  ///@brief File descriptor readable while the queue is not empty, created on first call.
+  ///
+  ///Lets an external event loop (epoll, libuv, asio...) wait for the events. -1 on Windows.
+  ///
+  std::int32_t ready_fd();
+
+  ///
+  ///@brief Bound the number of queued entries to \b capacity (0 for unbounded) and choose what happens when it is reached.
+  ///
+  ///Key repeats and the priority lane don't use more entries.
+  ///
+  void set_capacity(const std::size_t& capacity, const Term::OverflowPolicy& policy);
+
+  ///
+  ///@brief Number of events dropped because the queue was full.
+  ///
+  std::size_t overflows();
+
+  ///
+  ///@brief Number of times a producer waited for room with Term::OverflowPolicy::Block.
+  ///
+  std::size_t waits();
+
+  ///
+  ///@brief While interrupted, a producer doesn't wait for room with Term::OverflowPolicy::Block and its event is dropped.
+  ///
+  void interrupt(const bool& interrupt);
 
 private:
-  std::mutex              m_mutex;
-  std::queue<Term::Event> m_queue;
-  std::condition_variable m_cv;
+  bool                     coalesce(const Term::Event& value);
+  bool                     repeat(const Term::Event& value, const std::size_t& occurrence);
+  void                     push_priority(Term::Event&& value);
+  bool                     wait(std::unique_lock<std::mutex>& lock, const std::chrono::milliseconds& timeout);
+  bool                     make_room(std::unique_lock<std::mutex>& lock);
+  void                     push_back(Term::Event&& value);
+  Term::Event              pop_front();
+  Term::Event&             back();
+  void                     notify();
+  std::mutex               m_mutex;
+  std::condition_variable  m_cv;
+  std::condition_variable  m_not_full;
+  std::vector<Term::Event> m_ring;
+  std::vector<Term::Event> m_priority;  // latest Screen and Focus events
+  std::size_t              m_head{0};
+  std::size_t              m_size{0};
+  std::size_t              m_waiting{0};
+  std::size_t              m_count{0};  // events including the repeats and the priority lane
+  bool                     m_coalesce_motion{false};
+  bool                     m_coalesce_repeat{false};
+  std::size_t              m_capacity{0};
+  Term::OverflowPolicy     m_policy{Term::OverflowPolicy::DropOldestMotion};
+  std::size_t              m_overflows{0};
+  std::size_t              m_waits{0};
+  std::size_t              m_blocked{0};
+  bool                     m_interrupted{false};
+  std::unique_ptr<EventFd> m_ready;
 };
 
 }  // namespace Private
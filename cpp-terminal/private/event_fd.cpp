@@ -0,0 +1,88 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#include "cpp-terminal/private/event_fd.hpp"
+
+#include "cpp-terminal/private/exception.hpp"
+
+#if defined(_WIN32)
+  #pragma warning(push)
+  #pragma warning(disable : 4668)
+  #define WIN32_LEAN_AND_MEAN
+  #include <windows.h>
+  #pragma warning(pop)
+#elif defined(__linux__)
+  #include <sys/eventfd.h>
+  #include <unistd.h>
+#else
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+
+#include <array>
+
+Term::Private::EventFd::EventFd()
+{
+#if defined(_WIN32)
+  Term::Private::WindowsError().check_if((m_handle = CreateEventA(nullptr, TRUE, FALSE, nullptr)) == nullptr).throw_exception("CreateEventA(nullptr, TRUE, FALSE, nullptr)");
+#elif defined(__linux__)
+  Term::Private::Errno().check_if((m_read = ::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)) == -1).throw_exception("::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC)");
+  m_write = m_read;
+#else
+  std::array<int, 2> fds{{-1, -1}};
+  Term::Private::Errno().check_if(::pipe(fds.data()) == -1).throw_exception("::pipe(fds.data())");
+  m_read  = fds[0];
+  m_write = fds[1];
+  for(const int& fd: fds)
+  {
+    Term::Private::Errno().check_if(::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK) == -1).throw_exception("::fcntl(fd, F_SETFL, O_NONBLOCK)");  //NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+    Term::Private::Errno().check_if(::fcntl(fd, F_SETFD, FD_CLOEXEC) == -1).throw_exception("::fcntl(fd, F_SETFD, FD_CLOEXEC)");                        //NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+  }
+#endif
+}
+
+Term::Private::EventFd::~EventFd() noexcept
+{
+#if defined(_WIN32)
+  CloseHandle(m_handle);
+#else
+  if(m_write != m_read) { ::close(m_write); }
+  ::close(m_read);
+#endif
+}
+
+std::int32_t Term::Private::EventFd::fd() const noexcept { return m_read; }
+
+void* Term::Private::EventFd::handle() const noexcept { return m_handle; }
+
+void Term::Private::EventFd::signal() const noexcept
+{
+#if defined(_WIN32)
+  SetEvent(m_handle);
+#elif defined(__linux__)
+  const std::uint64_t one{1};
+  static_cast<void>(::write(m_write, &one, sizeof(one)));
+#else
+  const char one{1};
+  static_cast<void>(::write(m_write, &one, sizeof(one)));
+#endif
+}
+
+void Term::Private::EventFd::clear() const noexcept
+{
+#if defined(_WIN32)
+  ResetEvent(m_handle);
+#elif defined(__linux__)
+  std::uint64_t value{0};
+  static_cast<void>(::read(m_read, &value, sizeof(value)));
+#else
+  std::array<char, 64> buffer{};
+  while(::read(m_read, buffer.data(), buffer.size()) > 0) {}
+#endif
+}
@@ -0,0 +1,63 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include <cstdint>
+
+namespace Term
+{
+
+namespace Private
+{
+
+///
+///@brief File descriptor that can be made readable on demand.
+///
+///Backed by an \b eventfd on Linux and by a non-blocking pipe on other POSIX systems, it lets a thread wake up a \b poll / \b epoll waiting on it. On Windows it is a manual-reset event to wait on with handle() and fd() returns -1.
+///
+class EventFd
+{
+public:
+  EventFd();
+  ~EventFd() noexcept;
+  EventFd(const EventFd&)            = delete;
+  EventFd(EventFd&&)                 = delete;
+  EventFd& operator=(const EventFd&) = delete;
+  EventFd& operator=(EventFd&&)      = delete;
+
+  ///
+  ///@brief File descriptor to watch for readability.
+  ///
+  std::int32_t fd() const noexcept;
+
+  ///
+  ///@brief Event handle to wait for on Windows, \b nullptr elsewhere.
+  ///
+  void* handle() const noexcept;
+
+  ///
+  ///@brief Make fd() readable.
+  ///
+  void signal() const noexcept;
+
+  ///
+  ///@brief Make fd() not readable anymore.
+  ///
+  void clear() const noexcept;
+
+private:
+  std::int32_t m_read{-1};
+  std::int32_t m_write{-1};
+  void*        m_handle{nullptr};
+};
+
+}  // namespace Private
+
+}  // namespace Term
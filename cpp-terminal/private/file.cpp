@@ -9,9 +9,14 @@
 
 #include "cpp-terminal/private/file.hpp"
 
+#include "cpp-terminal/output.hpp"
 #include "cpp-terminal/private/exception.hpp"
+#include "cpp-terminal/private/recorder.hpp"
+#include "cpp-terminal/private/screen_size.hpp"
+#include "cpp-terminal/private/writer.hpp"
 #include "cpp-terminal/tty.hpp"
 
+#include <cerrno>
 #include <cstdio>
 #include <new>
 
@@ -23,19 +28,94 @@
   #include <windows.h>
   #pragma warning(pop)
 #else
+  #include <climits>
+  #include <poll.h>
   #include <sys/ioctl.h>
+  #include <sys/uio.h>
   #include <unistd.h>
 #endif
 
 #include "cpp-terminal/private/unicode.hpp"
 
+#include <algorithm>
 #include <array>
+#include <chrono>
 #include <fcntl.h>
 
 //FIXME Move this to other file
 
 namespace
 {
+#if defined(MAX_INPUT)
+const constexpr std::size_t max_input{MAX_INPUT};
+#else
+const constexpr std::size_t max_input{256};
+#endif
+#if defined(_POSIX_MAX_INPUT)
+const constexpr std::size_t posix_max_input{_POSIX_MAX_INPUT};
+#else
+const constexpr std::size_t posix_max_input{256};
+#endif
+#if !defined(_WIN32)
+// Write all the iovecs, continuing after short writes, EINTR and (in non-blocking mode) EAGAIN. The iovecs are modified.
+std::size_t write_all(const int& fd, ::iovec* iovecs, std::size_t count, const std::chrono::milliseconds& timeout, Term::Private::OutputCounters& counters)
+{
+  std::size_t                                 written{0};
+  std::chrono::steady_clock::time_point       deadline{std::chrono::steady_clock::time_point::max()};
+  const std::chrono::steady_clock::time_point begin{std::chrono::steady_clock::now()};
+  bool                                        waited{false};  // The terminal was behind, the duration of the write measures how fast it consumes.
+  while(count != 0)
+  {
+    std::size_t size{0};
+    for(std::size_t i = 0; i != count; ++i) { size += iovecs[i].iov_len; }  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+    const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+    const ::ssize_t                             ret{count == 1 ? ::write(fd, iovecs->iov_base, iovecs->iov_len) : ::writev(fd, iovecs, static_cast<int>(count))};
+    const int                                   error{errno};
+    const std::chrono::steady_clock::time_point end{std::chrono::steady_clock::now()};
+    ++counters.writes;
+    counters.blocked += std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    if(end - start >= std::chrono::milliseconds(1)) { waited = true; }
+    if(ret == -1)
+    {
+      if(error == EINTR) continue;
+      if(error != EAGAIN && error != EWOULDBLOCK) { throw Term::Private::ErrnoException(error, "::writev(fd, iovecs, count)"); }
+      // The terminal doesn't accept more data for now, wait for it (only happens in non-blocking mode).
+      ++counters.would_block;
+      waited = true;
+      // A timeout too large to be represented (std::chrono::milliseconds::max()...) never expires.
+      if(deadline == std::chrono::steady_clock::time_point::max() && timeout < std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::time_point::max() - end)) { deadline = end + timeout; }
+      if(end >= deadline) { throw Term::Exception("Timeout writing to the terminal (" + std::to_string(written) + " bytes written)"); }
+      ::pollfd pfd{fd, POLLOUT, 0};
+      const int wait{deadline == std::chrono::steady_clock::time_point::max() ? -1 : static_cast<int>(std::min<std::chrono::milliseconds::rep>(std::chrono::duration_cast<std::chrono::milliseconds>(deadline - end).count() + 1, INT_MAX))};
+      if(::poll(&pfd, 1, wait) == -1 && errno != EINTR) { throw Term::Private::ErrnoException(errno, "::poll(&pfd, 1, wait)"); }
+      counters.blocked += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - end).count();
+      continue;
+    }
+    counters.bytes += static_cast<std::uint64_t>(ret);
+    if(static_cast<std::size_t>(ret) != size) { ++counters.short_writes; }
+    written += static_cast<std::size_t>(ret);
+    // Skip what has been written and continue after a short write.
+    std::size_t left{static_cast<std::size_t>(ret)};
+    while(count != 0 && left >= iovecs->iov_len)
+    {
+      left -= iovecs->iov_len;
+      ++iovecs;  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      --count;
+    }
+    if(count != 0)
+    {
+      iovecs->iov_base = static_cast<char*>(iovecs->iov_base) + left;  //NOLINT(cppcoreguidelines-pro-bounds-pointer-arithmetic)
+      iovecs->iov_len -= left;
+    }
+  }
+  if(waited)
+  {
+    counters.waited_bytes += written;
+    counters.waited_time += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count();
+  }
+  return written;
+}
+#endif
 std::array<char, sizeof(Term::Private::InputFileHandler)>  stdin_buffer;   //NOLINT(fuchsia-statically-constructed-objects)
 std::array<char, sizeof(Term::Private::OutputFileHandler)> stdout_buffer;  //NOLINT(fuchsia-statically-constructed-objects)
 }  // namespace
@@ -65,8 +145,7 @@ Term::Private::FileHandler::FileHandler(std::recursive_mutex& mutex, const std::
     Term::Private::Errno().check_if((m_fd = _open_osfhandle(reinterpret_cast<intptr_t>(m_handle), _O_RDWR)) == -1).throw_exception("_open_osfhandle(reinterpret_cast<intptr_t>(m_handle), _O_RDWR)");
     Term::Private::Errno().check_if(nullptr == (m_file = _fdopen(m_fd, mode.c_str()))).throw_exception("_fdopen(m_fd, mode.c_str())");
 #else
-    std::size_t flag{O_ASYNC | O_DSYNC | O_NOCTTY | O_SYNC | O_NDELAY};
-    flag &= ~static_cast<std::size_t>(O_NONBLOCK);
+    std::size_t flag{O_NOCTTY};
     if(mode.find('r') != std::string::npos) { flag |= O_RDONLY; }       //NOLINT(abseil-string-find-str-contains)
     else if(mode.find('w') != std::string::npos) { flag |= O_WRONLY; }  //NOLINT(abseil-string-find-str-contains)
     else { flag |= O_RDWR; }
@@ -87,6 +166,20 @@ Term::Private::FileHandler::FileHandler(std::recursive_mutex& mutex, const std::
   }
 }
 
+Term::Private::FileHandler::FileHandler(std::recursive_mutex& mutex, const std::int32_t& fd, const std::string& mode) : m_mutex(mutex)
+{
+#if defined(_WIN32)
+  Term::Private::Errno().check_if((m_fd = _dup(fd)) == -1).throw_exception("_dup(fd)");
+  m_handle = reinterpret_cast<Handle>(_get_osfhandle(m_fd));
+  Term::Private::Errno().check_if(nullptr == (m_file = _fdopen(m_fd, mode.c_str()))).throw_exception("_fdopen(m_fd, mode.c_str())");
+#else
+  Term::Private::Errno().check_if((m_fd = ::dup(fd)) == -1).throw_exception("::dup(fd)");
+  Term::Private::Errno().check_if(nullptr == (m_file = ::fdopen(m_fd, mode.c_str()))).throw_exception("::fdopen(m_fd, mode.c_str())");
+  m_handle = m_file;
+#endif
+  Term::Private::Errno().check_if(std::setvbuf(m_file, nullptr, _IONBF, 0) != 0).throw_exception("std::setvbuf(m_file, nullptr, _IONBF, 0)");
+}
+
 Term::Private::FileHandler::~FileHandler() noexcept
 {
   try
@@ -110,6 +203,16 @@ catch(...)
   ExceptionHandler(ExceptionDestination::StdErr);
 }
 
+Term::Private::OutputFileHandler::OutputFileHandler(std::recursive_mutex& io_mutex, const std::int32_t& fd) : FileHandler(io_mutex, fd, "w") {}
+
+Term::Private::OutputFileHandler::~OutputFileHandler()
+{
+#if !defined(_WIN32)
+  // Don't leave a duplicated descriptor of the caller non-blocking.
+  if(m_flags != -1) { ::fcntl(fd(), F_SETFL, m_flags); }  //NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+#endif
+}
+
 Term::Private::InputFileHandler::InputFileHandler(std::recursive_mutex& io_mutex) noexcept
 try : FileHandler(io_mutex, m_file, "r")
 {
@@ -120,6 +223,8 @@ catch(...)
   ExceptionHandler(ExceptionDestination::StdErr);
 }
 
+Term::Private::InputFileHandler::InputFileHandler(std::recursive_mutex& io_mutex, const std::int32_t& fd) : FileHandler(io_mutex, fd, "r") {}
+
 #ifdef _WIN32
   #pragma warning(pop)
 #endif
@@ -134,30 +239,270 @@ Term::Private::FileHandler::Handle Term::Private::FileHandler::handle() const no
 
 std::size_t Term::Private::OutputFileHandler::write(const std::string& str) const
 {
+  if(queue())
+  {
+    m_writer->write(str);
+    return str.size();
+  }
+  return write_sync(str.data(), str.size());
+}
+
+std::size_t Term::Private::OutputFileHandler::write(const char& character) const
+{
+  if(queue())
+  {
+    m_writer->write(std::string(1, character));
+    return 1;
+  }
+  return write_sync(&character, 1);
+}
+
+std::size_t Term::Private::OutputFileHandler::write(const char* data, const std::size_t& size) const
+{
+  if(queue())
+  {
+    m_writer->write(std::string(data, size));
+    return size;
+  }
+  return write_sync(data, size);
+}
+
+std::size_t Term::Private::OutputFileHandler::write(const std::vector<std::reference_wrapper<const std::string>>& buffers) const
+{
+  if(queue())
+  {
+    m_writer->write(buffers);
+    std::size_t size{0};
+    for(const std::string& buffer: buffers) { size += buffer.size(); }
+    return size;
+  }
 #if defined(_WIN32)
-  DWORD written{0};
-  if(!str.empty()) { Term::Private::WindowsError().check_if(0 == WriteConsole(handle(), &str[0], static_cast<DWORD>(str.size()), &written, nullptr)).throw_exception("WriteConsole(handle(), &str[0], static_cast<DWORD>(str.size()), &written, nullptr)"); }
-  return static_cast<std::size_t>(written);
+  std::size_t written{0};
+  for(const std::string& buffer: buffers) { written += write_sync(buffer.data(), buffer.size()); }
+  return written;
 #else
-  ssize_t written{0};
-  if(!str.empty()) { Term::Private::Errno().check_if((written = ::write(fd(), str.data(), str.size())) == -1).throw_exception("::write(fd(), str.data(), str.size())"); }
-  return static_cast<std::size_t>(written);
+  #if defined(IOV_MAX)
+  static const constexpr std::size_t iov_max{IOV_MAX};
+  #else
+  static const constexpr std::size_t iov_max{16};
+  #endif
+  std::array<::iovec, 64> iovecs{};
+  std::size_t             written{0};
+  std::size_t             count{0};
+  for(std::size_t i = 0; i != buffers.size(); ++i)
+  {
+    const std::string& buffer = buffers[i].get();
+    if(!buffer.empty())
+    {
+      if(m_recording.load(std::memory_order_relaxed) && !m_direct.load(std::memory_order_relaxed)) { record(buffer.data(), buffer.size()); }
+      iovecs[count].iov_base = const_cast<char*>(buffer.data());  //NOLINT(cppcoreguidelines-pro-type-const-cast)
+      iovecs[count].iov_len  = buffer.size();
+      ++count;
+    }
+    if(count != 0 && (count == std::min(iovecs.size(), iov_max) || i + 1 == buffers.size()))
+    {
+      written += write_all(fd(), iovecs.data(), count, std::chrono::milliseconds(m_timeout.load()), m_counters);
+      count = 0;
+    }
+  }
+  return written;
 #endif
 }
 
-std::size_t Term::Private::OutputFileHandler::write(const char& character) const
+std::size_t Term::Private::OutputFileHandler::write_sync(const char* data, const std::size_t& size) const
 {
+  if(size == 0) return 0;
+  if(m_recording.load(std::memory_order_relaxed) && !m_direct.load(std::memory_order_relaxed)) { record(data, size); }
 #if defined(_WIN32)
-  DWORD written{0};
-  Term::Private::WindowsError().check_if(0 == WriteConsole(handle(), &character, 1, &written, nullptr)).throw_exception("WriteConsole(handle(), &character, 1, &written, nullptr)");
+  DWORD                                       written{0};
+  const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+  Term::Private::WindowsError().check_if(0 == WriteConsole(handle(), data, static_cast<DWORD>(size), &written, nullptr)).throw_exception("WriteConsole(handle(), data, static_cast<DWORD>(size), &written, nullptr)");
+  ++m_counters.writes;
+  m_counters.blocked += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+  m_counters.bytes += written;
+  if(written != size) { ++m_counters.short_writes; }
   return static_cast<std::size_t>(written);
 #else
-  ssize_t written{0};
-  Term::Private::Errno().check_if((written = ::write(fd(), &character, 1)) == -1).throw_exception("::write(fd(), &character, 1)");
-  return static_cast<std::size_t>(written);
+  ::iovec iov{const_cast<char*>(data), size};  //NOLINT(cppcoreguidelines-pro-type-const-cast)
+  return write_all(fd(), &iov, 1, std::chrono::milliseconds(m_timeout.load()), m_counters);
 #endif
 }
 
+void Term::Private::OutputFileHandler::setAsync(const bool& async)
+{
+  if(async == (m_writer != nullptr)) return;
+  if(async)
+  {
+    m_writer = std::unique_ptr<Writer>(new Writer([this](const std::string& data) { write_sync(data.data(), data.size()); }, m_written_frame.load()));
+  }
+  else
+  {
+    m_writer.reset();
+    m_written_frame.store(m_frame.load());
+  }
+}
+
+bool Term::Private::OutputFileHandler::async() const noexcept { return m_writer != nullptr; }
+
+bool Term::Private::OutputFileHandler::setDirect(const bool& direct) noexcept { return m_direct.exchange(direct); }
+
+bool Term::Private::OutputFileHandler::queue() const noexcept { return m_writer && !m_direct.load(std::memory_order_relaxed); }
+
+void Term::Private::OutputFileHandler::drain() const
+{
+  if(m_writer) { m_writer->drain(); }
+}
+
+std::uint64_t Term::Private::OutputFileHandler::writeFrame(std::string&& frame, const std::uint64_t& base) const
+{
+  const std::uint64_t id{++m_frame};
+  if(queue())
+  {
+    switch(m_writer->writeFrame(std::move(frame), id, base))
+    {
+      case Writer::FrameStatus::Stale: return 0;
+      case Writer::FrameStatus::Replaced: ++m_counters.replaced_frames; break;
+      case Writer::FrameStatus::Queued: break;
+    }
+  }
+  else
+  {
+    const std::lock_guard<std::mutex> lock(m_frame_mutex);
+    if(base != 0 && base != committedFrame()) return 0;
+    write_sync(frame.data(), frame.size());
+    m_written_frame.store(id);
+  }
+  return id;
+}
+
+std::uint64_t Term::Private::OutputFileHandler::committedFrame() const noexcept
+{
+  if(m_writer) { return std::max(m_writer->committedFrame(), m_written_frame.load()); }
+  return m_written_frame.load();
+}
+
+std::uint64_t Term::Private::OutputFileHandler::writtenFrame() const noexcept
+{
+  if(m_writer) { return std::max(m_writer->writtenFrame(), m_written_frame.load()); }
+  return m_written_frame.load();
+}
+
+void Term::Private::OutputFileHandler::setMode(const Term::OutputMode& mode, const std::chrono::milliseconds& timeout)
+{
+  m_timeout.store(timeout.count());
+#if !defined(_WIN32)
+  // The flag is set on the file description. /dev/tty is opened by the library and has its own, but the duplicate of a descriptor (Term::Session) shares it with the caller's descriptor: the original flags are restored by the destructor.
+  int flags{0};
+  Term::Private::Errno().check_if((flags = ::fcntl(fd(), F_GETFL)) == -1).throw_exception("::fcntl(fd(), F_GETFL)");  //NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+  if(m_flags == -1) { m_flags = flags; }
+  if(mode == Term::OutputMode::NonBlocking) { flags |= O_NONBLOCK; }  //NOLINT(hicpp-signed-bitwise)
+  else { flags &= ~O_NONBLOCK; }                                      //NOLINT(hicpp-signed-bitwise)
+  Term::Private::Errno().check_if(::fcntl(fd(), F_SETFL, flags) == -1).throw_exception("::fcntl(fd(), F_SETFL, flags)");  //NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+#endif
+  m_mode.store(mode);
+}
+
+Term::OutputMode Term::Private::OutputFileHandler::mode() const noexcept { return m_mode.load(); }
+
+Term::OutputStats Term::Private::OutputFileHandler::stats() const noexcept
+{
+  Term::OutputStats stats;
+  stats.bytes           = m_counters.bytes.load();
+  stats.writes          = m_counters.writes.load();
+  stats.short_writes    = m_counters.short_writes.load();
+  stats.would_block     = m_counters.would_block.load();
+  stats.blocked         = std::chrono::nanoseconds(m_counters.blocked.load());
+  stats.replaced_frames = m_counters.replaced_frames.load();
+  return stats;
+}
+
+Term::Private::DrainSample Term::Private::drain_estimate(const DrainSample& previous, const DrainSample& sample) noexcept
+{
+  DrainSample next{previous};
+  const auto  update = [&next](const double& rate) { next.rate = next.rate == 0 ? rate : 0.75 * next.rate + 0.25 * rate; };
+  if(sample.waited_bytes < next.waited_bytes || sample.waited_time < next.waited_time)  // reset_output_stats()
+  {
+    next.waited_bytes = sample.waited_bytes;
+    next.waited_time  = sample.waited_time;
+  }
+  const std::chrono::duration<double> elapsed{sample.time - next.time};
+  if(elapsed >= std::chrono::milliseconds(10))
+  {
+    // The queue never emptied between the two samples (serial lines, sockets...): the terminal consumed at full speed.
+    if(next.queued != 0 && sample.queued != 0 && sample.drained >= next.drained) { update(static_cast<double>(sample.drained - next.drained) / elapsed.count()); }
+    next.time    = sample.time;
+    next.drained = sample.drained;
+    next.queued  = sample.queued;
+  }
+  // Otherwise use the writes that had to wait for the terminal, the only source for ptys (their queue is always reported empty on Linux).
+  const std::chrono::nanoseconds waited{sample.waited_time - next.waited_time};
+  if(sample.queued == 0 && waited >= std::chrono::milliseconds(10))
+  {
+    update(static_cast<double>(sample.waited_bytes - next.waited_bytes) / std::chrono::duration<double>(waited).count());
+    next.waited_bytes = sample.waited_bytes;
+    next.waited_time  = sample.waited_time;
+  }
+  return next;
+}
+
+Term::OutputBacklog Term::Private::OutputFileHandler::backlog() const
+{
+  Term::OutputBacklog backlog;
+  if(m_writer) { backlog.pending = m_writer->pending(); }
+#if defined(TIOCOUTQ)
+  int queued{0};
+  if(!null() && ::ioctl(fd(), TIOCOUTQ, &queued) == 0 && queued > 0) { backlog.queued = static_cast<std::size_t>(queued); }  //NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+#endif
+  const std::uint64_t bytes{m_counters.bytes.load()};
+  DrainSample         sample;
+  sample.time         = std::chrono::steady_clock::now();
+  sample.drained      = bytes > backlog.queued ? bytes - backlog.queued : 0;  // Other writers to the tty (std::cout...) are in the queue too.
+  sample.queued       = backlog.queued;
+  sample.waited_bytes = m_counters.waited_bytes.load();
+  sample.waited_time  = m_counters.waited_time.load();
+  const std::lock_guard<std::mutex> lock(m_drain_mutex);
+  m_drain = drain_estimate(m_drain, sample);
+  backlog.drain_rate = m_drain.rate;
+  return backlog;
+}
+
+void Term::Private::OutputFileHandler::startRecording(const std::string& path)
+{
+  std::atomic_store(&m_recorder, std::make_shared<Recorder>(path, ScreenSize::query()));
+  m_recording.store(true);
+}
+
+void Term::Private::OutputFileHandler::stopRecording()
+{
+  m_recording.store(false);
+  std::atomic_store(&m_recorder, std::shared_ptr<Recorder>());  // The file is closed once the writes in progress are done with it.
+}
+
+void Term::Private::OutputFileHandler::record(const char* data, const std::size_t& size) const
+{
+  const std::shared_ptr<Recorder> recorder{std::atomic_load(&m_recorder)};
+  if(recorder) { recorder->output(data, size); }
+}
+
+void Term::Private::OutputFileHandler::recordResize(const Term::Screen& screen) const
+{
+  if(!m_recording.load(std::memory_order_relaxed)) return;
+  const std::shared_ptr<Recorder> recorder{std::atomic_load(&m_recorder)};
+  if(recorder) { recorder->resize(screen); }
+}
+
+void Term::Private::OutputFileHandler::resetStats() noexcept
+{
+  m_counters.bytes.store(0);
+  m_counters.writes.store(0);
+  m_counters.short_writes.store(0);
+  m_counters.would_block.store(0);
+  m_counters.blocked.store(0);
+  m_counters.waited_bytes.store(0);
+  m_counters.waited_time.store(0);
+  m_counters.replaced_frames.store(0);
+}
+
 std::string Term::Private::InputFileHandler::read() const
 {
 #if defined(_WIN32)
@@ -167,16 +512,6 @@ std::string Term::Private::InputFileHandler::read() const
   ReadConsole(Private::in.handle(), &ret[0], static_cast<DWORD>(ret.size()), &nread, nullptr);
   return ret.c_str();
 #else
-  #if defined(MAX_INPUT)
-  static const constexpr std::size_t max_input{MAX_INPUT};
-  #else
-  static const constexpr std::size_t max_input{256};
-  #endif
-  #if defined(_POSIX_MAX_INPUT)
-  static const constexpr std::size_t posix_max_input{_POSIX_MAX_INPUT};
-  #else
-  static const constexpr std::size_t posix_max_input{256};
-  #endif
   static std::size_t nread{std::max(max_input, posix_max_input)};
   if(is_stdin_a_tty()) Term::Private::Errno().check_if(::ioctl(Private::in.fd(), FIONREAD, &nread) != 0).throw_exception("::ioctl(Private::in.fd(), FIONREAD, &nread)");  //NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
   std::string ret(nread, '\0');
@@ -188,6 +523,45 @@ std::string Term::Private::InputFileHandler::read() const
 #endif
 }
 
+std::size_t Term::Private::InputFileHandler::read(std::string& buffer) const
+{
+#if defined(_WIN32)
+  buffer = read();
+  return buffer.size();
+#else
+  // Only expose one chunk: resizing to the whole capacity left by a big paste would clear megabytes for each key.
+  buffer.resize(std::max(max_input, posix_max_input));
+  std::size_t total{0};
+  while(true)
+  {
+    const ::ssize_t nread{::read(fd(), &buffer[total], buffer.size() - total)};  //NOLINT(readability-container-data-pointer)
+    if(nread == -1)
+    {
+      if(errno == EINTR) continue;
+      if(errno != EAGAIN && errno != EWOULDBLOCK) { throw Term::Private::ErrnoException(errno, "::read(fd(), &buffer[total], buffer.size() - total)"); }
+      break;
+    }
+    if(nread == 0)
+    {
+      if(total == 0) { m_eof.store(true); }
+      break;
+    }
+    total += static_cast<std::size_t>(nread);
+    if(total != buffer.size()) break;
+    // The buffer is full, only ask how much is left in this case.
+    int pending{0};
+    if(::ioctl(fd(), FIONREAD, &pending) != 0 || pending <= 0) break;  //NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+    buffer.resize(buffer.size() + static_cast<std::size_t>(pending));
+  }
+  buffer.resize(total);
+  return total;
+#endif
+}
+
+bool Term::Private::InputFileHandler::eof() const noexcept { return m_eof.load(); }
+
+Term::Private::MouseDecoder& Term::Private::InputFileHandler::mouse() noexcept { return m_mouse; }
+
 void Term::Private::FileHandler::flush() { Term::Private::Errno().check_if(0 != std::fflush(m_file)).throw_exception("std::fflush(m_file)"); }
 
 void Term::Private::FileHandler::lockIO() { m_mutex.lock(); }
@@ -200,3 +574,27 @@ std::string Term::Private::ask(const std::string& str)
   for(std::size_t i = 0; i != ret.size(); ++i) { Term::Private::out.write("\b \b"); }
   return ret;
 }
+
+void Term::set_async_output(const bool& async) { Term::Private::out.setAsync(async); }
+
+void Term::flush_output() { Term::Private::out.drain(); }
+
+std::uint64_t Term::submit_frame(std::string frame, const std::uint64_t& base) { return Term::Private::out.writeFrame(std::move(frame), base); }
+
+std::uint64_t Term::last_committed_frame() { return Term::Private::out.committedFrame(); }
+
+std::uint64_t Term::last_written_frame() { return Term::Private::out.writtenFrame(); }
+
+std::size_t Term::write_output(const std::vector<std::reference_wrapper<const std::string>>& buffers) { return Term::Private::out.write(buffers); }
+
+void Term::set_output_mode(const Term::OutputMode& mode, const std::chrono::milliseconds& timeout) { Term::Private::out.setMode(mode, timeout); }
+
+Term::OutputStats Term::output_stats() { return Term::Private::out.stats(); }
+
+void Term::reset_output_stats() { Term::Private::out.resetStats(); }
+
+void Term::start_recording(const std::string& path) { Term::Private::out.startRecording(path); }
+
+void Term::stop_recording() { Term::Private::out.stopRecording(); }
+
+Term::OutputBacklog Term::output_backlog() { return Term::Private::out.backlog(); }
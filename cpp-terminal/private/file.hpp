@@ -9,13 +9,21 @@
 
 #pragma once
 
+#include "cpp-terminal/output.hpp"
 #include "cpp-terminal/private/file_initializer.hpp"
+#include "cpp-terminal/private/mouse_decoder.hpp"
+#include "cpp-terminal/screen.hpp"
 // clang-format off
+#include <atomic>
+#include <chrono>
 #include <cstdio>
 #include <cstddef>
 #include <cstdint>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <string>
+#include <vector>
 // clang-format on
 
 namespace Term
@@ -24,6 +32,40 @@ namespace Term
 namespace Private
 {
 
+class Recorder;
+class Writer;
+
+struct OutputCounters
+{
+  std::atomic<std::uint64_t> bytes{0};
+  std::atomic<std::uint64_t> writes{0};
+  std::atomic<std::uint64_t> short_writes{0};
+  std::atomic<std::uint64_t> would_block{0};
+  std::atomic<std::int64_t>  blocked{0};  // nanoseconds
+  std::atomic<std::uint64_t> waited_bytes{0};  // written by the writes that had to wait for the terminal
+  std::atomic<std::int64_t>  waited_time{0};   // nanoseconds, duration of these writes
+  std::atomic<std::uint64_t> replaced_frames{0};
+};
+
+struct DrainSample
+{
+  std::chrono::steady_clock::time_point time;
+  std::uint64_t                         drained{0};  // bytes written minus the ones still queued
+  std::size_t                           queued{0};
+  std::uint64_t                         waited_bytes{0};
+  std::int64_t                          waited_time{0};
+  double                                rate{0};  // bytes per second
+};
+
+///
+///@brief Estimate the drain rate from the sample of the previous call and the counters sampled now (the rate of \b sample is ignored).
+///
+///The rate is an exponential moving average. It's updated from the bytes leaving the queue when it stays non-empty for at least 10ms, and from the writes that had to wait once they lasted 10ms.
+///
+///@return The sample to give to the next call, with the updated rate.
+///
+DrainSample drain_estimate(const DrainSample& previous, const DrainSample& sample) noexcept;
+
 class FileHandler
 {
 public:
@@ -33,6 +75,10 @@ public:
   using Handle = FILE*;
 #endif
   FileHandler(std::recursive_mutex& mutex, const std::string& file, const std::string& mode) noexcept;
+  ///
+  ///@brief Use a duplicate of \b fd (pty, socket...), the caller keeps the ownership of \b fd.
+  ///
+  FileHandler(std::recursive_mutex& mutex, const std::int32_t& fd, const std::string& mode);
   FileHandler(const FileHandler&)            = delete;
   FileHandler(FileHandler&&)                 = delete;
   FileHandler& operator=(const FileHandler&) = delete;
@@ -59,25 +105,112 @@ class OutputFileHandler : public FileHandler
 {
 public:
   explicit OutputFileHandler(std::recursive_mutex& io_mutex) noexcept;
+  OutputFileHandler(std::recursive_mutex& io_mutex, const std::int32_t& fd);
   OutputFileHandler(const OutputFileHandler& other)          = delete;
   OutputFileHandler(OutputFileHandler&& other)               = delete;
   OutputFileHandler& operator=(OutputFileHandler&& rhs)      = delete;
   OutputFileHandler& operator=(const OutputFileHandler& rhs) = delete;
-  ~OutputFileHandler() override                              = default;
+  ~OutputFileHandler() override;
 
   std::size_t write(const std::string& str) const;
   std::size_t write(const char& character) const;
+  std::size_t write(const char* data, const std::size_t& size) const;
+
+  ///
+  ///@brief Write several buffers in order with a single \b writev instead of concatenating them first.
+  ///
+  std::size_t write(const std::vector<std::reference_wrapper<const std::string>>& buffers) const;
+
+  ///
+  ///@brief Hand the writes to a background thread instead of writing from the caller's thread.
+  ///
+  void setAsync(const bool& async);
+  bool async() const noexcept;
+
+  ///
+  ///@brief Wait until the data handed to the background thread has been written.
+  ///
+  void drain() const;
+
+  ///
+  ///@brief Write from the caller's thread even when the output is asynchronous, bypassing the background thread and the recording.
+  ///
+  ///@note Used by the terminal cleanup which also runs in the signal handlers: it must neither take the writer lock nor only queue the data.
+  ///@return The previous setting, to restore it once the direct writes are done.
+  ///
+  bool setDirect(const bool& direct) noexcept;
+
+  ///
+  ///@brief Write a complete frame, when the output is asynchronous it replaces the frame still waiting to be written if any.
+  ///
+  ///@param base : Id of the frame \b frame is a diff against, 0 for a full redraw.
+  ///@return The id of the frame, 0 if \b base isn't the committed frame anymore (the frame is dropped).
+  ///
+  std::uint64_t writeFrame(std::string&& frame, const std::uint64_t& base) const;
+
+  ///
+  ///@brief Id of the last frame written, or being written, to the terminal, 0 if none. The next frames are diffed against it.
+  ///
+  std::uint64_t committedFrame() const noexcept;
+
+  ///
+  ///@brief Id of the last frame written to the terminal, 0 if none.
+  ///
+  std::uint64_t writtenFrame() const noexcept;
+
+  ///
+  ///@brief Switch the terminal file descriptor between blocking and non-blocking writes.
+  ///
+  ///@param timeout : In non-blocking mode, how long a write waits for the terminal to accept more data before throwing.
+  ///@note The flag belongs to the file description, shared with the descriptor given to the constructor if any: the original flags are restored by the destructor.
+  ///
+  void             setMode(const Term::OutputMode& mode, const std::chrono::milliseconds& timeout);
+  Term::OutputMode mode() const noexcept;
+
+  Term::OutputStats stats() const noexcept;
+  void              resetStats() noexcept;
+
+  ///
+  ///@brief Append everything written to the terminal, and the resizes, to the asciicast v2 file \b path.
+  ///
+  void startRecording(const std::string& path);
+  void stopRecording();
+  void recordResize(const Term::Screen& screen) const;
+
+  ///
+  ///@brief Bytes still queued and estimated drain rate, sampled at each call.
+  ///
+  Term::OutputBacklog backlog() const;
 #if defined(_WIN32)
   static const constexpr char* m_file{"CONOUT$"};
 #else
   static const constexpr char* m_file{"/dev/tty"};
 #endif
+
+private:
+  std::size_t                        write_sync(const char* data, const std::size_t& size) const;
+  void                               record(const char* data, const std::size_t& size) const;
+  bool                               queue() const noexcept;
+  std::unique_ptr<Writer>            m_writer;
+  std::atomic<bool>                  m_direct{false};
+  mutable std::atomic<std::uint64_t> m_frame{0};          // id of the last frame submitted
+  mutable std::atomic<std::uint64_t> m_written_frame{0};  // when written synchronously
+  mutable std::mutex                 m_frame_mutex;       // checks the base of a synchronous frame and writes it at once
+  std::atomic<Term::OutputMode>      m_mode{Term::OutputMode::Blocking};
+  std::atomic<std::int64_t>          m_timeout{5000};  // milliseconds
+  mutable OutputCounters             m_counters;
+  std::atomic<bool>                  m_recording{false};
+  std::shared_ptr<Recorder>          m_recorder;  // std::atomic_load/store
+  mutable std::mutex                 m_drain_mutex;
+  mutable DrainSample                m_drain;
+  int                                m_flags{-1};  // file status flags before the first setMode(), -1 if untouched
 };
 
 class InputFileHandler : public FileHandler
 {
 public:
   explicit InputFileHandler(std::recursive_mutex& io_mutex) noexcept;
+  InputFileHandler(std::recursive_mutex& io_mutex, const std::int32_t& fd);
   InputFileHandler(const InputFileHandler&)            = delete;
   InputFileHandler(InputFileHandler&&)                 = delete;
   InputFileHandler& operator=(InputFileHandler&&)      = delete;
@@ -85,11 +218,32 @@ public:
   ~InputFileHandler() override                         = default;
 
   std::string read() const;
+  ///
+  ///@brief Read the pending input into \b buffer, reusing its capacity.
+  ///
+  ///@warning Only call it once the input is readable, the read blocks otherwise.
+  ///@return The number of bytes read, \b 0 if nothing was available after all or at the end of the input (see eof()).
+  ///
+  std::size_t read(std::string& buffer) const;
+
+  ///
+  ///@brief \b true once a read has reached the end of the input (the other side has closed it).
+  ///
+  bool eof() const noexcept;
+
+  ///
+  ///@brief Decoder of the mouse reports read from this input, each input keeps its own click history.
+  ///
+  Term::Private::MouseDecoder& mouse() noexcept;
 #if defined(_WIN32)
   static const constexpr char* m_file{"CONIN$"};
 #else
   static const constexpr char* m_file{"/dev/tty"};
 #endif
+
+private:
+  Term::Private::MouseDecoder m_mouse;
+  mutable std::atomic<bool>   m_eof{false};
 };
 
 extern InputFileHandler&     in;
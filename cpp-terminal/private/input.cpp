@@ -18,11 +18,11 @@
 #elif defined(__APPLE__) || defined(__wasm__) || defined(__wasm) || defined(__EMSCRIPTEN__)
   #include <cerrno>
   #include <csignal>
+  #include <poll.h>
   #include <sys/ioctl.h>
   #include <thread>
   #include <unistd.h>
 #else
-  #include <memory>
   #include <sys/epoll.h>
 #endif
 
@@ -30,13 +30,48 @@
 #include "cpp-terminal/exception.hpp"
 #include "cpp-terminal/input.hpp"
 #include "cpp-terminal/private/blocking_queue.hpp"
+#include "cpp-terminal/private/event_fd.hpp"
 #include "cpp-terminal/private/file.hpp"
 #include "cpp-terminal/private/input.hpp"
+#include "cpp-terminal/private/screen_size.hpp"
 #include "cpp-terminal/private/sigwinch.hpp"
 
-#include <mutex>
+#include <algorithm>
+#include <array>
+#include <limits>
 #include <string>
 
+namespace
+{
+// Timeout in milliseconds for the system wait functions, -1 to wait forever.
+int to_timeout(const std::chrono::milliseconds& timeout)
+{
+  if(timeout == std::chrono::milliseconds::max()) return -1;
+  return static_cast<int>(std::min<std::chrono::milliseconds::rep>(std::max<std::chrono::milliseconds::rep>(timeout.count(), 0), std::numeric_limits<int>::max()));
+}
+
+// Remaining time rounded up to the millisecond so we don't spin during the last one.
+std::chrono::milliseconds remaining(const std::chrono::steady_clock::time_point& deadline)
+{
+  const std::chrono::steady_clock::duration left{deadline - std::chrono::steady_clock::now()};
+  if(left <= std::chrono::steady_clock::duration::zero()) return std::chrono::milliseconds::zero();
+  return std::chrono::duration_cast<std::chrono::milliseconds>(left + std::chrono::milliseconds(1) - std::chrono::steady_clock::duration(1));
+}
+
+// Length of the escape sequence repeated all along the chunk ("\033[B\033[B\033[B" when a key repeats faster than it is read), 0 if there is none.
+std::size_t repeated_sequence(const std::string& chunk)
+{
+  if(chunk.size() < 4 || chunk[0] != '\033') return 0;
+  const std::size_t length{chunk.find('\033', 1)};
+  if(length == std::string::npos || chunk.size() % length != 0) return 0;
+  for(std::size_t i = length; i != chunk.size(); i += length)
+  {
+    if(chunk.compare(i, length, chunk, 0, length) != 0) return 0;
+  }
+  return length;
+}
+}  // namespace
+
 #if defined(_WIN32)
 Term::Button::Action getAction(const std::int32_t& old_state, const std::int32_t& state, const std::int32_t& type)
 {
@@ -67,20 +102,17 @@ Term::Button setButton(const std::int32_t& old_state, const std::int32_t& state)
   return Term::Button(Term::Button::Type::None, Term::Button::Action::None);
 }
 
-void sendString(Term::Private::BlockingQueue& events, std::wstring& str)
+void Term::Private::Input::sendString(std::wstring& str)
 {
   if(!str.empty())
   {
-    events.push(Term::Event(Term::Private::to_narrow(str.c_str())));
+    push(Term::Event(Term::Private::to_narrow(str.c_str())));
     str.clear();
   }
 }
 
 #endif
-Term::Private::Input::~Input()
-{
-  if(m_thread.joinable()) m_thread.join();
-}
+Term::Private::Input::~Input() { stopReading(); }
 
 std::thread Term::Private::Input::m_thread{};
 
@@ -88,8 +120,41 @@ Term::Private::BlockingQueue Term::Private::Input::m_events;
 
 int Term::Private::Input::m_poll{-1};
 
-void Term::Private::Input::init_thread()
+Term::InputMode Term::Private::Input::m_mode{Term::InputMode::Thread};
+
+std::atomic<bool> Term::Private::Input::m_activated{false};
+
+std::mutex Term::Private::Input::m_activation;
+
+std::atomic<bool> Term::Private::Input::m_stop{false};
+
+std::unique_ptr<Term::Private::EventFd> Term::Private::Input::m_wake{nullptr};
+
+std::atomic<std::chrono::milliseconds::rep> Term::Private::Input::m_resize_debounce{0};
+
+bool Term::Private::Input::m_resize_pending{false};
+
+std::chrono::steady_clock::time_point Term::Private::Input::m_resize_deadline{};
+
+std::size_t Term::Private::Input::m_capacity{0};
+
+Term::OverflowPolicy Term::Private::Input::m_policy{Term::OverflowPolicy::DropOldestMotion};
+
+std::chrono::steady_clock::time_point Term::Private::Input::m_read_time{};
+
+std::string Term::Private::Input::m_buffer;
+
+void Term::Private::Input::push(Term::Event&& event, const std::size_t& occurrence)
 {
+  event.stamp(m_read_time);
+  if(event.get_if_screen() != nullptr) { Term::Private::out.recordResize(*event.get_if_screen()); }
+  m_events.push(std::move(event), occurrence);
+}
+
+void Term::Private::Input::init()
+{
+  if(m_wake != nullptr) return;
+  m_wake = std::unique_ptr<Term::Private::EventFd>(new Term::Private::EventFd());
 #if defined(__linux__)
   m_poll = {::epoll_create1(EPOLL_CLOEXEC)};
   ::epoll_event signal;
@@ -100,7 +165,15 @@ void Term::Private::Input::init_thread()
   input.events  = {EPOLLIN};
   input.data.fd = {Term::Private::in.fd()};
   ::epoll_ctl(m_poll, EPOLL_CTL_ADD, Term::Private::in.fd(), &input);
+  ::epoll_event wake;
+  wake.events  = {EPOLLIN};
+  wake.data.fd = {m_wake->fd()};
+  ::epoll_ctl(m_poll, EPOLL_CTL_ADD, m_wake->fd(), &wake);
 #endif
+}
+
+void Term::Private::Input::init_thread()
+{
   if(m_thread.joinable()) m_thread.join();
   std::thread thread(Term::Private::Input::read_event);
   m_thread.swap(thread);
@@ -108,24 +181,65 @@ void Term::Private::Input::init_thread()
 
 void Term::Private::Input::read_event()
 {
-  while(true)
-  {
+  while(!m_stop.load()) { wait_and_read(std::chrono::milliseconds::max()); }
+}
+
+void Term::Private::Input::wait_and_read(const std::chrono::milliseconds& timeout)
+{
+  std::chrono::milliseconds wait{timeout};
+  if(m_resize_pending) { wait = std::min(wait, remaining(m_resize_deadline)); }
 #if defined(_WIN32)
-    WaitForSingleObject(Term::Private::in.handle(), INFINITE);
-    read_raw();
+  const std::array<HANDLE, 2> handles{{Term::Private::in.handle(), m_wake->handle()}};
+  if(WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), FALSE, wait == std::chrono::milliseconds::max() ? INFINITE : static_cast<DWORD>(to_timeout(wait))) == WAIT_OBJECT_0) read_raw();
 #elif defined(__APPLE__) || defined(__wasm__) || defined(__wasm) || defined(__EMSCRIPTEN__)
-    if(Term::Private::Sigwinch::isSigwinch()) m_events.push(screen_size());
-    read_raw();
+  std::array<::pollfd, 2> fds{{{Term::Private::in.fd(), POLLIN, 0}, {m_wake->fd(), POLLIN, 0}}};
+  if(!Term::Private::Sigwinch::isSigwinch() && ::poll(fds.data(), fds.size(), to_timeout(wait)) > 0 && (fds[0].revents & POLLIN) != 0) read_raw();
+  // SIGWINCH interrupts poll()
+  if(Term::Private::Sigwinch::isSigwinch()) { resized(); }
 #else
-    ::epoll_event ret;
-    if(epoll_wait(m_poll, &ret, 1, -1) == 1)
-    {
-      if(Term::Private::Sigwinch::isSigwinch(ret.data.fd)) m_events.push(Term::Screen(screen_size()));
-      else
-        read_raw();
-    }
+  ::epoll_event ret;
+  if(epoll_wait(m_poll, &ret, 1, to_timeout(wait)) == 1)
+  {
+    if(ret.data.fd == m_wake->fd()) return;
+    if(Term::Private::Sigwinch::isSigwinch(ret.data.fd)) { resized(); }
+    else
+      read_raw();
+  }
 #endif
+  if(m_resize_pending && std::chrono::steady_clock::now() >= m_resize_deadline)
+  {
+    m_resize_pending = false;
+    m_read_time      = std::chrono::steady_clock::now();
+    push(m_mode == Term::InputMode::Thread ? ScreenSize::update() : ScreenSize::query());
+  }
+}
+
+void Term::Private::Input::resized()
+{
+  m_read_time = std::chrono::steady_clock::now();
+  const std::chrono::milliseconds debounce{m_resize_debounce.load()};
+  if(debounce == std::chrono::milliseconds::zero())
+  {
+    push(m_mode == Term::InputMode::Thread ? ScreenSize::update() : ScreenSize::query());
+    return;
+  }
+  // The size is changing, ask the terminal until it settles.
+  ScreenSize::invalidate();
+  m_resize_pending  = true;
+  m_resize_deadline = m_read_time + debounce;
+}
+
+void Term::Private::Input::read_inline(const std::chrono::milliseconds& timeout)
+{
+  if(timeout == std::chrono::milliseconds::max())
+  {
+    while(m_events.empty()) { wait_and_read(timeout); }
+    return;
   }
+  const std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::now() + timeout};
+  do {
+    wait_and_read(remaining(deadline));
+  } while(m_events.empty() && std::chrono::steady_clock::now() < deadline);
 }
 
 #if defined(_WIN32)
@@ -156,51 +270,51 @@ void Term::Private::Input::read_windows_key(const std::uint16_t& virtual_key_cod
     case VK_ACCEPT:      // ?
     case VK_MODECHANGE:  // ?
       break;
-    case VK_PRIOR: m_events.push(std::move(toAdd + Term::Key(Key::Value::PageUp)), occurrence); break;
-    case VK_NEXT: m_events.push(std::move(toAdd + Term::Key(Key::Value::PageDown)), occurrence); break;
-    case VK_END: m_events.push(std::move(toAdd + Term::Key(Key::Value::End)), occurrence); break;
-    case VK_HOME: m_events.push(std::move(toAdd + Term::Key(Key::Value::Home)), occurrence); break;
-    case VK_LEFT: m_events.push(std::move(toAdd + Term::Key(Key::Value::ArrowLeft)), occurrence); break;
-    case VK_UP: m_events.push(std::move(toAdd + Term::Key(Key::Value::ArrowUp)), occurrence); break;
-    case VK_RIGHT: m_events.push(std::move(toAdd + Term::Key(Key::Value::ArrowRight)), occurrence); break;
-    case VK_DOWN: m_events.push(std::move(toAdd + Term::Key(Key::Value::ArrowDown)), occurrence); break;
+    case VK_PRIOR: push(std::move(toAdd + Term::Key(Key::Value::PageUp)), occurrence); break;
+    case VK_NEXT: push(std::move(toAdd + Term::Key(Key::Value::PageDown)), occurrence); break;
+    case VK_END: push(std::move(toAdd + Term::Key(Key::Value::End)), occurrence); break;
+    case VK_HOME: push(std::move(toAdd + Term::Key(Key::Value::Home)), occurrence); break;
+    case VK_LEFT: push(std::move(toAdd + Term::Key(Key::Value::ArrowLeft)), occurrence); break;
+    case VK_UP: push(std::move(toAdd + Term::Key(Key::Value::ArrowUp)), occurrence); break;
+    case VK_RIGHT: push(std::move(toAdd + Term::Key(Key::Value::ArrowRight)), occurrence); break;
+    case VK_DOWN: push(std::move(toAdd + Term::Key(Key::Value::ArrowDown)), occurrence); break;
     case VK_SELECT:   //?
     case VK_PRINT:    //?
     case VK_EXECUTE:  //?
       break;
-    case VK_SNAPSHOT: m_events.push(std::move(toAdd + Term::Key(Key::Value::PrintScreen)), occurrence); break;
-    case VK_INSERT: m_events.push(std::move(toAdd + Term::Key(Key::Value::Insert)), occurrence); break;
-    case VK_DELETE: m_events.push(std::move(toAdd + Term::Key(Key::Value::Del)), occurrence); break;
+    case VK_SNAPSHOT: push(std::move(toAdd + Term::Key(Key::Value::PrintScreen)), occurrence); break;
+    case VK_INSERT: push(std::move(toAdd + Term::Key(Key::Value::Insert)), occurrence); break;
+    case VK_DELETE: push(std::move(toAdd + Term::Key(Key::Value::Del)), occurrence); break;
     case VK_HELP:   //?
     case VK_LWIN:   //Maybe allow to detect Windows key Left and right
     case VK_RWIN:   //Maybe allow to detect Windows key Left and right
     case VK_APPS:   //?
     case VK_SLEEP:  //?
       break;
-    case VK_F1: m_events.push(std::move(toAdd + Term::Key(Key::Value::F1)), occurrence); break;
-    case VK_F2: m_events.push(std::move(toAdd + Term::Key(Key::Value::F2)), occurrence); break;
-    case VK_F3: m_events.push(std::move(toAdd + Term::Key(Key::Value::F3)), occurrence); break;
-    case VK_F4: m_events.push(std::move(toAdd + Term::Key(Key::Value::F4)), occurrence); break;
-    case VK_F5: m_events.push(std::move(toAdd + Term::Key(Key::Value::F5)), occurrence); break;
-    case VK_F6: m_events.push(std::move(toAdd + Term::Key(Key::Value::F6)), occurrence); break;
-    case VK_F7: m_events.push(std::move(toAdd + Term::Key(Key::Value::F7)), occurrence); break;
-    case VK_F8: m_events.push(std::move(toAdd + Term::Key(Key::Value::F8)), occurrence); break;
-    case VK_F9: m_events.push(std::move(toAdd + Term::Key(Key::Value::F9)), occurrence); break;
-    case VK_F10: m_events.push(std::move(toAdd + Term::Key(Key::Value::F10)), occurrence); break;
-    case VK_F11: m_events.push(std::move(toAdd + Term::Key(Key::Value::F11)), occurrence); break;
-    case VK_F12: m_events.push(std::move(toAdd + Term::Key(Key::Value::F12)), occurrence); break;
-    case VK_F13: m_events.push(std::move(toAdd + Term::Key(Key::Value::F13)), occurrence); break;
-    case VK_F14: m_events.push(std::move(toAdd + Term::Key(Key::Value::F14)), occurrence); break;
-    case VK_F15: m_events.push(std::move(toAdd + Term::Key(Key::Value::F15)), occurrence); break;
-    case VK_F16: m_events.push(std::move(toAdd + Term::Key(Key::Value::F16)), occurrence); break;
-    case VK_F17: m_events.push(std::move(toAdd + Term::Key(Key::Value::F17)), occurrence); break;
-    case VK_F18: m_events.push(std::move(toAdd + Term::Key(Key::Value::F18)), occurrence); break;
-    case VK_F19: m_events.push(std::move(toAdd + Term::Key(Key::Value::F19)), occurrence); break;
-    case VK_F20: m_events.push(std::move(toAdd + Term::Key(Key::Value::F20)), occurrence); break;
-    case VK_F21: m_events.push(std::move(toAdd + Term::Key(Key::Value::F21)), occurrence); break;
-    case VK_F22: m_events.push(std::move(toAdd + Term::Key(Key::Value::F22)), occurrence); break;
-    case VK_F23: m_events.push(std::move(toAdd + Term::Key(Key::Value::F23)), occurrence); break;
-    case VK_F24: m_events.push(std::move(toAdd + Term::Key(Key::Value::F24)), occurrence); break;
+    case VK_F1: push(std::move(toAdd + Term::Key(Key::Value::F1)), occurrence); break;
+    case VK_F2: push(std::move(toAdd + Term::Key(Key::Value::F2)), occurrence); break;
+    case VK_F3: push(std::move(toAdd + Term::Key(Key::Value::F3)), occurrence); break;
+    case VK_F4: push(std::move(toAdd + Term::Key(Key::Value::F4)), occurrence); break;
+    case VK_F5: push(std::move(toAdd + Term::Key(Key::Value::F5)), occurrence); break;
+    case VK_F6: push(std::move(toAdd + Term::Key(Key::Value::F6)), occurrence); break;
+    case VK_F7: push(std::move(toAdd + Term::Key(Key::Value::F7)), occurrence); break;
+    case VK_F8: push(std::move(toAdd + Term::Key(Key::Value::F8)), occurrence); break;
+    case VK_F9: push(std::move(toAdd + Term::Key(Key::Value::F9)), occurrence); break;
+    case VK_F10: push(std::move(toAdd + Term::Key(Key::Value::F10)), occurrence); break;
+    case VK_F11: push(std::move(toAdd + Term::Key(Key::Value::F11)), occurrence); break;
+    case VK_F12: push(std::move(toAdd + Term::Key(Key::Value::F12)), occurrence); break;
+    case VK_F13: push(std::move(toAdd + Term::Key(Key::Value::F13)), occurrence); break;
+    case VK_F14: push(std::move(toAdd + Term::Key(Key::Value::F14)), occurrence); break;
+    case VK_F15: push(std::move(toAdd + Term::Key(Key::Value::F15)), occurrence); break;
+    case VK_F16: push(std::move(toAdd + Term::Key(Key::Value::F16)), occurrence); break;
+    case VK_F17: push(std::move(toAdd + Term::Key(Key::Value::F17)), occurrence); break;
+    case VK_F18: push(std::move(toAdd + Term::Key(Key::Value::F18)), occurrence); break;
+    case VK_F19: push(std::move(toAdd + Term::Key(Key::Value::F19)), occurrence); break;
+    case VK_F20: push(std::move(toAdd + Term::Key(Key::Value::F20)), occurrence); break;
+    case VK_F21: push(std::move(toAdd + Term::Key(Key::Value::F21)), occurrence); break;
+    case VK_F22: push(std::move(toAdd + Term::Key(Key::Value::F22)), occurrence); break;
+    case VK_F23: push(std::move(toAdd + Term::Key(Key::Value::F23)), occurrence); break;
+    case VK_F24: push(std::move(toAdd + Term::Key(Key::Value::F24)), occurrence); break;
     case VK_NUMLOCK:
     case VK_SCROLL:
     default: break;
@@ -217,6 +331,7 @@ void Term::Private::Input::read_raw()
   DWORD                     read{0};
   std::vector<INPUT_RECORD> events{to_read};
   if(!ReadConsoleInputW(Private::in.handle(), &events[0], to_read, &read) || read != to_read) Term::Exception("ReadFile() failed");
+  m_read_time = std::chrono::steady_clock::now();
   std::wstring ret;
   bool         need_windows_size{false};
   for(std::size_t i = 0; i != read; ++i)
@@ -235,18 +350,18 @@ void Term::Private::Input::read_raw()
       }
       case FOCUS_EVENT:
       {
-        sendString(m_events, ret);
-        m_events.push(Event(Focus(static_cast<Term::Focus::Type>(events[i].Event.FocusEvent.bSetFocus))));
+        sendString(ret);
+        push(Event(Focus(static_cast<Term::Focus::Type>(events[i].Event.FocusEvent.bSetFocus))));
         break;
       }
       case MENU_EVENT:
       {
-        sendString(m_events, ret);
+        sendString(ret);
         break;
       }
       case MOUSE_EVENT:
       {
-        sendString(m_events, ret);
+        sendString(ret);
         static MOUSE_EVENT_RECORD old_state;
         if(events[i].Event.MouseEvent.dwEventFlags == MOUSE_WHEELED || events[i].Event.MouseEvent.dwEventFlags == MOUSE_HWHEELED)
           ;
@@ -257,33 +372,33 @@ void Term::Private::Input::read_raw()
         {
           case 0:
           {
-            m_events.push(Term::Mouse(setButton(static_cast<std::int32_t>(old_state.dwButtonState), state), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.Y), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.X)));
+            push(Term::Mouse(setButton(static_cast<std::int32_t>(old_state.dwButtonState), state), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.Y), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.X)));
             ;
             break;
           }
           case MOUSE_MOVED:
           {
-            m_events.push(Term::Mouse(setButton(static_cast<std::int32_t>(old_state.dwButtonState), state), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.Y), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.X)));
+            push(Term::Mouse(setButton(static_cast<std::int32_t>(old_state.dwButtonState), state), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.Y), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.X)));
             ;
             break;
           }
           case DOUBLE_CLICK:
           {
-            m_events.push(Term::Mouse(Term::Button(setButton(static_cast<std::int32_t>(old_state.dwButtonState), state).type(), Term::Button::Action::DoubleClicked), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.Y), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.X)));
+            push(Term::Mouse(Term::Button(setButton(static_cast<std::int32_t>(old_state.dwButtonState), state).type(), Term::Button::Action::DoubleClicked), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.Y), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.X)));
             break;
           }
           case MOUSE_WHEELED:
           {
-            if(state > 0) m_events.push(Term::Mouse(Button(Term::Button::Type::Wheel, Term::Button::Action::RolledUp), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.Y), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.X)));
+            if(state > 0) push(Term::Mouse(Button(Term::Button::Type::Wheel, Term::Button::Action::RolledUp), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.Y), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.X)));
             else
-              m_events.push(Term::Mouse(Button(Term::Button::Type::Wheel, Term::Button::Action::RolledDown), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.Y), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.X)));
+              push(Term::Mouse(Button(Term::Button::Type::Wheel, Term::Button::Action::RolledDown), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.Y), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.X)));
             break;
           }
           case MOUSE_HWHEELED:
           {
-            if(state > 0) m_events.push(Term::Mouse(Button(Term::Button::Type::Wheel, Term::Button::Action::ToRight), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.Y), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.X)));
+            if(state > 0) push(Term::Mouse(Button(Term::Button::Type::Wheel, Term::Button::Action::ToRight), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.Y), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.X)));
             else
-              m_events.push(Term::Mouse(Button(Term::Button::Type::Wheel, Term::Button::Action::ToLeft), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.Y), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.X)));
+              push(Term::Mouse(Button(Term::Button::Type::Wheel, Term::Button::Action::ToLeft), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.Y), static_cast<std::uint16_t>(events[i].Event.MouseEvent.dwMousePosition.X)));
             break;
           }
           default: break;
@@ -294,19 +409,31 @@ void Term::Private::Input::read_raw()
       case WINDOW_BUFFER_SIZE_EVENT:
       {
         need_windows_size = true;  // if we send directly it's too much generations
-        sendString(m_events, ret);
+        sendString(ret);
         break;
       }
       default: break;
     }
   }
-  sendString(m_events, ret);
-  if(need_windows_size == true) { m_events.push(screen_size()); }
+  sendString(ret);
+  if(need_windows_size == true) { resized(); }
 #else
   Private::in.lockIO();
-  std::string ret = Term::Private::in.read();
+  const std::size_t nread{Term::Private::in.read(m_buffer)};
   Private::in.unlockIO();
-  if(!ret.empty()) m_events.push(Event(ret.c_str()));
+  m_read_time = std::chrono::steady_clock::now();
+  if(nread != 0)
+  {
+    const std::size_t length{repeated_sequence(m_buffer)};
+    if(length != 0)
+    {
+      Term::Event key(m_buffer.substr(0, length));
+      if(key.get_if_key() != nullptr) { return push(std::move(key), m_buffer.size() / length); }
+    }
+    Term::Event event(m_buffer);
+    if(event.get_if_mouse() != nullptr) { *event.get_if_mouse() = Term::Private::in.mouse().decode(*event.get_if_mouse(), m_read_time); }
+    push(std::move(event));
+  }
 #endif
 }
 
@@ -314,25 +441,122 @@ Term::Private::Input::Input() {}
 
 void Term::Private::Input::startReading()
 {
-  static bool activated{false};
-  if(!activated)
+  if(m_activated.load()) return;
+  // Several threads can read their first event at the same time, only one of them starts the reading.
+  const std::lock_guard<std::mutex> lock(m_activation);
+  if(m_activated.load()) return;
+  init();
+  if(m_mode == Term::InputMode::Thread)
   {
+    ScreenSize::update();
     init_thread();
-    m_thread.detach();
-    activated = true;
   }
+  m_activated.store(true);
+}
+
+void Term::Private::Input::stopReading()
+{
+  const std::lock_guard<std::mutex> lock(m_activation);
+  if(m_thread.joinable() && m_thread.get_id() != std::this_thread::get_id())
+  {
+    m_stop.store(true);
+    m_wake->signal();
+    m_events.interrupt(true);
+    m_thread.join();
+    m_events.interrupt(false);
+    m_wake->clear();
+    m_stop.store(false);
+  }
+  // Nobody watches the resizes anymore.
+  ScreenSize::invalidate();
+  m_activated.store(false);
+}
+
+void Term::Private::Input::setMode(const Term::InputMode& mode)
+{
+  const std::lock_guard<std::mutex> lock(m_activation);
+  if(m_activated.load() && mode != m_mode) { throw Term::Exception("The input mode can't be changed once the input is read"); }
+  m_mode = mode;
+  apply_capacity();
+}
+
+void Term::Private::Input::setCapacity(const std::size_t& capacity, const Term::OverflowPolicy& policy)
+{
+  m_capacity = capacity;
+  m_policy   = policy;
+  apply_capacity();
+}
+
+void Term::Private::Input::apply_capacity()
+{
+  // Nobody else could make room while the caller's thread is reading.
+  if(m_mode == Term::InputMode::Threadless && m_policy == Term::OverflowPolicy::Block) { m_events.set_capacity(m_capacity, Term::OverflowPolicy::DropNewest); }
+  else { m_events.set_capacity(m_capacity, m_policy); }
 }
 
-Term::Event Term::Private::Input::getEvent() { return m_events.pop(); }
+std::size_t Term::Private::Input::overflows() { return m_events.overflows(); }
 
-Term::Event Term::Private::Input::getEventBlocking()
+std::size_t Term::Private::Input::waits() { return m_events.waits(); }
+
+std::size_t Term::Private::Input::poll(const std::chrono::milliseconds& timeout)
+{
+  if(m_mode == Term::InputMode::Threadless) { read_inline(timeout); }
+  else { m_events.wait_for_events(timeout); }
+  return m_events.size();
+}
+
+Term::Event Term::Private::Input::getEvent()
 {
-  static std::mutex                   cv_m;
-  static std::unique_lock<std::mutex> lk(cv_m);
-  if(m_events.empty()) m_events.wait_for_events(lk);
+  if(m_mode == Term::InputMode::Threadless) { read_inline(std::chrono::milliseconds::zero()); }
   return m_events.pop();
 }
 
+Term::Event Term::Private::Input::getEventBlocking() { return getEventFor(std::chrono::milliseconds::max()); }
+
+Term::Event Term::Private::Input::getEventFor(const std::chrono::milliseconds& timeout)
+{
+  if(m_mode == Term::InputMode::Threadless)
+  {
+    read_inline(timeout);
+    return m_events.pop();
+  }
+  return m_events.pop(timeout);
+}
+
+std::size_t Term::Private::Input::getEvents(std::vector<Term::Event>& events, const std::size_t& max, const std::chrono::milliseconds& timeout)
+{
+  if(m_mode == Term::InputMode::Threadless)
+  {
+    read_inline(timeout);
+    return m_events.pop(events, max, std::chrono::milliseconds::zero());
+  }
+  return m_events.pop(events, max, timeout);
+}
+
+std::int32_t Term::Private::Input::readyFd()
+{
+  if(m_mode == Term::InputMode::Threadless)
+  {
+    // Nothing fills the queue in the background, give what the caller's thread waits on instead.
+#if defined(__linux__)
+    return m_poll;
+#elif defined(_WIN32)
+    return -1;
+#else
+    return Term::Private::in.fd();
+#endif
+  }
+  return m_events.ready_fd();
+}
+
+void Term::Private::Input::setMotionCoalescing(const bool& coalesce) { m_events.set_motion_coalescing(coalesce); }
+
+void Term::Private::Input::setKeyRepeatCoalescing(const bool& coalesce) { m_events.set_repeat_coalescing(coalesce); }
+
+void Term::Private::Input::setResizeDebounce(const std::chrono::milliseconds& debounce) { m_resize_debounce.store(std::max(debounce, std::chrono::milliseconds::zero()).count()); }
+
+void Term::Private::Input::setDoubleClickInterval(const std::chrono::milliseconds& interval) { Term::Private::in.mouse().setDoubleClickInterval(interval); }
+
 static Term::Private::Input m_input;
 
 Term::Event Term::read_event()
@@ -340,3 +564,51 @@ Term::Event Term::read_event()
   m_input.startReading();
   return m_input.getEventBlocking();
 }
+
+Term::Event Term::try_read_event()
+{
+  m_input.startReading();
+  return m_input.getEvent();
+}
+
+Term::Event Term::read_event_for(const std::chrono::milliseconds& timeout)
+{
+  m_input.startReading();
+  return m_input.getEventFor(timeout);
+}
+
+std::int32_t Term::event_queue_fd()
+{
+  m_input.startReading();
+  return m_input.readyFd();
+}
+
+std::size_t Term::read_events(std::vector<Term::Event>& events, const std::size_t& max, const std::chrono::milliseconds& timeout)
+{
+  m_input.startReading();
+  return m_input.getEvents(events, max, timeout);
+}
+
+void Term::stop_reading() { m_input.stopReading(); }
+
+void Term::set_input_mode(const Term::InputMode& mode) { Term::Private::Input::setMode(mode); }
+
+std::size_t Term::poll_input(const std::chrono::milliseconds& timeout)
+{
+  m_input.startReading();
+  return m_input.poll(timeout);
+}
+
+void Term::coalesce_mouse_motion(const bool& coalesce) { Term::Private::Input::setMotionCoalescing(coalesce); }
+
+void Term::coalesce_key_repeat(const bool& coalesce) { Term::Private::Input::setKeyRepeatCoalescing(coalesce); }
+
+void Term::set_resize_debounce(const std::chrono::milliseconds& debounce) { Term::Private::Input::setResizeDebounce(debounce); }
+
+void Term::set_event_queue_capacity(const std::size_t& capacity, const Term::OverflowPolicy& policy) { Term::Private::Input::setCapacity(capacity, policy); }
+
+std::size_t Term::event_queue_overflows() { return Term::Private::Input::overflows(); }
+
+std::size_t Term::event_queue_waits() { return Term::Private::Input::waits(); }
+
+void Term::set_double_click_interval(const std::chrono::milliseconds& interval) { Term::Private::Input::setDoubleClickInterval(interval); }
@@ -10,9 +10,16 @@
 #pragma once
 
 #include "cpp-terminal/event.hpp"
+#include "cpp-terminal/input.hpp"
 
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace Term
 {
@@ -21,26 +28,74 @@ namespace Private
 {
 
 class BlockingQueue;
+class EventFd;
 
 class Input final
 {
 public:
   Input();
   ~Input();
-  static void        startReading();
-  static Term::Event getEvent();
-  static Term::Event getEventBlocking();
+  static void         startReading();
+  ///
+  ///@brief Stop and join the reading thread, the next startReading() starts a new one.
+  ///
+  static void         stopReading();
+  static void         setMode(const Term::InputMode& mode);
+  static std::size_t  poll(const std::chrono::milliseconds& timeout);
+  static Term::Event  getEvent();
+  static Term::Event  getEventBlocking();
+  static Term::Event  getEventFor(const std::chrono::milliseconds& timeout);
+  static std::size_t  getEvents(std::vector<Term::Event>& events, const std::size_t& max, const std::chrono::milliseconds& timeout);
+  static std::int32_t readyFd();
+  static void         setMotionCoalescing(const bool& coalesce);
+  static void         setKeyRepeatCoalescing(const bool& coalesce);
+  static void         setDoubleClickInterval(const std::chrono::milliseconds& interval);
+  static void         setResizeDebounce(const std::chrono::milliseconds& debounce);
+  static void         setCapacity(const std::size_t& capacity, const Term::OverflowPolicy& policy);
+  static std::size_t  overflows();
+  static std::size_t  waits();
 
 private:
+  static void init();
   static void read_event();
   static void read_raw();
+  ///
+  ///@brief Wait up to \b timeout for the terminal input or a resize and queue the corresponding events.
+  ///
+  static void wait_and_read(const std::chrono::milliseconds& timeout);
+  ///
+  ///@brief Read the terminal input on the caller's thread until an event is queued or \b timeout expires (Term::InputMode::Threadless).
+  ///
+  static void read_inline(const std::chrono::milliseconds& timeout);
+  ///
+  ///@brief The terminal has been resized, queue the Term::Screen event now or once the resize debounce delay is elapsed.
+  ///
+  static void resized();
+  static void apply_capacity();
+  ///
+  ///@brief Stamp the event with the time its bytes have been read and queue it.
+  ///
+  static void push(Term::Event&& event, const std::size_t& occurrence = 1);
 #if defined(_WIN32)
   static void read_windows_key(const std::uint16_t& virtual_key_code, const std::uint32_t& control_key_state, const std::size_t& occurrence);
+  static void sendString(std::wstring& str);
 #endif
-  static void                         init_thread();
-  static std::thread                  m_thread;
-  static Term::Private::BlockingQueue m_events;
-  static int                          m_poll;  // for linux
+  static void                                        init_thread();
+  static std::thread                                 m_thread;
+  static Term::Private::BlockingQueue                m_events;
+  static int                                         m_poll;  // for linux
+  static Term::InputMode                             m_mode;
+  static std::atomic<bool>                           m_activated;
+  static std::mutex                                  m_activation;  // serializes startReading() and stopReading()
+  static std::atomic<bool>                           m_stop;
+  static std::unique_ptr<Term::Private::EventFd>     m_wake;  // wakes up the reading thread
+  static std::chrono::steady_clock::time_point       m_read_time;
+  static std::string                                 m_buffer;  // reused by read_raw()
+  static std::atomic<std::chrono::milliseconds::rep> m_resize_debounce;
+  static bool                                        m_resize_pending;
+  static std::chrono::steady_clock::time_point       m_resize_deadline;
+  static std::size_t                                 m_capacity;
+  static Term::OverflowPolicy                        m_policy;
 };
 
 }  // namespace Private
@@ -0,0 +1,31 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#include "cpp-terminal/private/mouse_decoder.hpp"
+
+#include <cstdint>
+
+Term::Private::MouseDecoder::MouseDecoder(const std::chrono::milliseconds& interval) noexcept : m_interval(interval.count()) {}
+
+void Term::Private::MouseDecoder::setDoubleClickInterval(const std::chrono::milliseconds& interval) noexcept { m_interval.store(interval.count(), std::memory_order_relaxed); }
+
+std::chrono::milliseconds Term::Private::MouseDecoder::doubleClickInterval() const noexcept { return std::chrono::milliseconds(m_interval.load(std::memory_order_relaxed)); }
+
+Term::Mouse Term::Private::MouseDecoder::decode(const Term::Mouse& mouse, const std::chrono::steady_clock::time_point& time) noexcept
+{
+  const bool           not_too_long{time - m_last <= doubleClickInterval()};
+  const bool           same_place{m_previous.row() == m_before_previous.row() && m_before_previous.row() == mouse.row() && m_previous.column() == m_before_previous.column() && m_before_previous.column() == mouse.column()};
+  const bool           same_button{m_previous.getButton().type() == m_before_previous.getButton().type() && m_before_previous.getButton().type() == mouse.getButton().type()};
+  Term::Button::Action action{mouse.getButton().action()};
+  if(not_too_long && same_place && same_button && m_previous.getButton().action() == Term::Button::Action::Released && m_before_previous.getButton().action() == Term::Button::Action::Pressed && action == Term::Button::Action::Pressed) { action = Term::Button::Action::DoubleClicked; }
+  m_before_previous = m_previous;
+  m_previous        = Term::Mouse(Term::Button(mouse.getButton().type(), action), static_cast<std::uint16_t>(mouse.row()), static_cast<std::uint16_t>(mouse.column()));
+  m_last            = time;
+  return m_previous;
+}
@@ -0,0 +1,58 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include "cpp-terminal/mouse.hpp"
+
+#include <atomic>
+#include <chrono>
+
+namespace Term
+{
+
+namespace Private
+{
+
+///
+///@brief Stateful part of the mouse reports decoding.
+///
+///The terminal only reports presses and releases, double-clicks are detected here from the previous reports. Each reader owns its decoder so several terminals or threads don't share the click history.
+///
+class MouseDecoder
+{
+public:
+  explicit MouseDecoder(const std::chrono::milliseconds& interval = std::chrono::milliseconds(120)) noexcept;
+  MouseDecoder(const MouseDecoder&)            = delete;
+  MouseDecoder(MouseDecoder&&)                 = delete;
+  MouseDecoder& operator=(const MouseDecoder&) = delete;
+  MouseDecoder& operator=(MouseDecoder&&)      = delete;
+  ~MouseDecoder()                              = default;
+
+  ///
+  ///@brief Set the maximum delay between the release of a click and the next press to report a double-click.
+  ///
+  void                      setDoubleClickInterval(const std::chrono::milliseconds& interval) noexcept;
+  std::chrono::milliseconds doubleClickInterval() const noexcept;
+
+  ///
+  ///@brief Decode a mouse report read at \b time, a press following a click at the same place is turned into Term::Button::Action::DoubleClicked.
+  ///
+  Term::Mouse decode(const Term::Mouse& mouse, const std::chrono::steady_clock::time_point& time = std::chrono::steady_clock::now()) noexcept;
+
+private:
+  std::atomic<std::chrono::milliseconds::rep> m_interval;
+  std::chrono::steady_clock::time_point       m_last;
+  Term::Mouse                                 m_previous;
+  Term::Mouse                                 m_before_previous;
+};
+
+}  // namespace Private
+
+}  // namespace Term
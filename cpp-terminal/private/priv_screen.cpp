@@ -9,27 +9,6 @@
 
 #include "cpp-terminal/screen.hpp"
 
-#ifdef _WIN32
-  #pragma warning(push)
-  #pragma warning(disable : 4668)
-  #define WIN32_LEAN_AND_MEAN
-  #include <windows.h>
-  #pragma warning(pop)
-#else
-  #include <sys/ioctl.h>
-#endif
+#include "cpp-terminal/private/screen_size.hpp"
 
-#include "cpp-terminal/private/file.hpp"
-
-Term::Screen Term::screen_size()
-{
-#ifdef _WIN32
-  CONSOLE_SCREEN_BUFFER_INFO inf;
-  if(GetConsoleScreenBufferInfo(Private::out.handle(), &inf)) return Term::Screen({Term::Rows(inf.srWindow.Bottom - inf.srWindow.Top + 1), Term::Columns(inf.srWindow.Right - inf.srWindow.Left + 1)});
-  return {};
-#else
-  struct winsize window{0, 0, 0, 0};
-  if(ioctl(Private::out.fd(), TIOCGWINSZ, &window) != -1) return Term::Screen({Term::Rows(window.ws_row), Term::Columns(window.ws_col)});
-  return {};
-#endif
-}
+Term::Screen Term::screen_size() { return Term::Private::ScreenSize::get(); }
@@ -0,0 +1,194 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#include "cpp-terminal/private/recorder.hpp"
+
+#include "cpp-terminal/private/exception.hpp"
+#include "cpp-terminal/private/writer.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <ctime>
+#include <limits>
+#include <string>
+
+namespace
+{
+
+// Each record handed to the writer thread: type, microseconds since the start, size of the data, then the data.
+const constexpr std::size_t header_size{1 + sizeof(std::uint64_t) + sizeof(std::uint32_t)};
+
+// Length of the incomplete utf8 sequence ending \b data, 0 if the last sequence is complete.
+std::size_t incomplete_utf8(const char* data, const std::size_t& size)
+{
+  for(std::size_t i = 1; i <= std::min<std::size_t>(4, size); ++i)
+  {
+    const unsigned char byte{static_cast<unsigned char>(data[size - i])};
+    if((byte & 0xC0) == 0x80) continue;  // continuation byte
+    std::size_t length{1};
+    if((byte & 0xE0) == 0xC0) { length = 2; }
+    else if((byte & 0xF0) == 0xE0) { length = 3; }
+    else if((byte & 0xF8) == 0xF0) { length = 4; }
+    return length > i ? i : 0;
+  }
+  return 0;
+}
+
+// Length of the valid utf8 sequence starting \b data, 0 if it is invalid (bad or missing continuation byte, overlong form, surrogate, beyond U+10FFFF).
+std::size_t valid_utf8(const char* data, const std::size_t& size)
+{
+  const unsigned char lead{static_cast<unsigned char>(data[0])};
+  std::size_t         length{0};
+  char32_t            codepoint{0};
+  if(lead < 0x80) return 1;
+  if((lead & 0xE0) == 0xC0) { length = 2; codepoint = lead & 0x1Fu; }
+  else if((lead & 0xF0) == 0xE0) { length = 3; codepoint = lead & 0x0Fu; }
+  else if((lead & 0xF8) == 0xF0) { length = 4; codepoint = lead & 0x07u; }
+  else return 0;
+  if(length > size) return 0;
+  for(std::size_t i = 1; i != length; ++i)
+  {
+    const unsigned char byte{static_cast<unsigned char>(data[i])};
+    if((byte & 0xC0) != 0x80) return 0;
+    codepoint = (codepoint << 6) | (byte & 0x3Fu);
+  }
+  static const constexpr std::array<char32_t, 5> minimum{{0, 0, 0x80, 0x800, 0x10000}};
+  if(codepoint < minimum[length] || codepoint > 0x10FFFF || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) return 0;
+  return length;
+}
+
+// The asciicast players expect valid utf8, each invalid byte is replaced by U+FFFD.
+void append_json(std::string& line, const char* data, const std::size_t& size)
+{
+  std::size_t start{0};
+  for(std::size_t i = 0; i != size; ++i)
+  {
+    const unsigned char character{static_cast<unsigned char>(data[i])};
+    if(character >= 0x80)
+    {
+      const std::size_t length{valid_utf8(data + i, size - i)};
+      if(length != 0)
+      {
+        i += length - 1;
+        continue;
+      }
+      line.append(data + start, i - start);
+      start = i + 1;
+      line += "\\ufffd";
+      continue;
+    }
+    if(character >= 0x20 && character != '"' && character != '\\') continue;
+    line.append(data + start, i - start);
+    start = i + 1;
+    switch(character)
+    {
+      case '"': line += "\\\""; break;
+      case '\\': line += "\\\\"; break;
+      case '\n': line += "\\n"; break;
+      case '\r': line += "\\r"; break;
+      case '\t': line += "\\t"; break;
+      default:
+      {
+        std::array<char, 7> escaped{};
+        std::snprintf(escaped.data(), escaped.size(), "\\u%04x", character);
+        line.append(escaped.data(), 6);
+        break;
+      }
+    }
+  }
+  line.append(data + start, size - start);
+}
+
+}  // namespace
+
+Term::Private::Recorder::Recorder(const std::string& path, const Term::Screen& screen) : m_start(std::chrono::steady_clock::now())
+{
+  Term::Private::Errno().check_if(nullptr == (m_file = std::fopen(path.c_str(), "wb"))).throw_exception("std::fopen(path.c_str(), \"wb\")");
+  std::fprintf(m_file, "{\"version\": 2, \"width\": %zu, \"height\": %zu, \"timestamp\": %lld}\n", static_cast<std::size_t>(screen.columns()), static_cast<std::size_t>(screen.rows()), static_cast<long long>(std::time(nullptr)));
+  std::fflush(m_file);
+  m_writer = std::unique_ptr<Writer>(new Writer([this](const std::string& records) { format(records); }));
+}
+
+Term::Private::Recorder::~Recorder() noexcept
+{
+  try
+  {
+    m_writer.reset();  // An incomplete utf8 sequence left at the end can't be displayed, it's dropped.
+    Term::Private::Errno().check_if(0 != std::fclose(m_file)).throw_exception("std::fclose(m_file)");
+  }
+  catch(...)
+  {
+    ExceptionHandler(ExceptionDestination::StdErr);
+  }
+}
+
+void Term::Private::Recorder::output(const char* data, const std::size_t& size)
+{
+  // Split what doesn't fit in the size of a record.
+  for(std::size_t done = 0; done < size; done += std::numeric_limits<std::uint32_t>::max()) { record('o', data + done, std::min<std::size_t>(size - done, std::numeric_limits<std::uint32_t>::max())); }
+}
+
+void Term::Private::Recorder::resize(const Term::Screen& screen)
+{
+  const std::string size{std::to_string(static_cast<std::size_t>(screen.columns())) + "x" + std::to_string(static_cast<std::size_t>(screen.rows()))};
+  record('r', size.data(), size.size());
+}
+
+void Term::Private::Recorder::record(const char& type, const char* data, const std::size_t& size)
+{
+  const std::uint64_t time{static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - m_start).count())};
+  const std::uint32_t length{static_cast<std::uint32_t>(size)};
+  std::string         header(header_size, type);  // fits in the small string buffer
+  std::memcpy(&header[1], &time, sizeof(time));
+  std::memcpy(&header[1 + sizeof(time)], &length, sizeof(length));
+  m_writer->write(header, data, size);
+}
+
+// Called from the writer thread.
+void Term::Private::Recorder::format(const std::string& records)
+{
+  std::size_t position{0};
+  while(position + header_size <= records.size())
+  {
+    const char    type{records[position]};
+    std::uint64_t time{0};
+    std::uint32_t length{0};
+    std::memcpy(&time, &records[position + 1], sizeof(time));
+    std::memcpy(&length, &records[position + 1 + sizeof(time)], sizeof(length));
+    const char* data{&records[position + header_size]};
+    position += header_size + length;
+
+    std::array<char, 48> prefix{};
+    const int            prefix_size{std::snprintf(prefix.data(), prefix.size(), "[%llu.%06llu, \"%c\", \"", static_cast<unsigned long long>(time / 1000000), static_cast<unsigned long long>(time % 1000000), type)};
+    m_line.assign(prefix.data(), static_cast<std::size_t>(prefix_size));
+    if(type == 'o')
+    {
+      // A write can cut a utf8 sequence, its beginning is kept for the next output.
+      const char* begin{data};
+      std::size_t size{length};
+      if(!m_incomplete.empty())
+      {
+        m_incomplete.append(data, length);
+        begin = m_incomplete.data();
+        size  = m_incomplete.size();
+      }
+      const std::size_t incomplete{incomplete_utf8(begin, size)};
+      append_json(m_line, begin, size - incomplete);
+      const std::string rest(begin + size - incomplete, incomplete);
+      m_incomplete = rest;
+      if(incomplete == size) continue;
+    }
+    else { append_json(m_line, data, length); }
+    m_line += "\"]\n";
+    std::fwrite(m_line.data(), 1, m_line.size(), m_file);
+  }
+  std::fflush(m_file);
+}
@@ -0,0 +1,64 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include "cpp-terminal/screen.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <string>
+
+namespace Term
+{
+
+namespace Private
+{
+
+class Writer;
+
+///
+///@brief Record the output in an asciicast v2 file (https://docs.asciinema.org/manual/asciicast/v2/).
+///
+///The caller only timestamps the data and hands it to a background Writer, the JSON formatting and the file writes happen in the writer thread.
+///
+class Recorder
+{
+public:
+  ///
+  ///@brief Create (truncate) the file \b path and write the header.
+  ///
+  Recorder(const std::string& path, const Term::Screen& screen);
+  Recorder(const Recorder&)            = delete;
+  Recorder(Recorder&&)                 = delete;
+  Recorder& operator=(const Recorder&) = delete;
+  Recorder& operator=(Recorder&&)      = delete;
+  ///
+  ///@brief Write what is pending and close the file.
+  ///
+  ~Recorder() noexcept;
+
+  void output(const char* data, const std::size_t& size);
+  void resize(const Term::Screen& screen);
+
+private:
+  void                                  record(const char& type, const char* data, const std::size_t& size);
+  void                                  format(const std::string& records);
+  std::FILE*                            m_file{nullptr};
+  std::chrono::steady_clock::time_point m_start;
+  std::string                           m_incomplete;  // utf8 sequence cut by a write, written with the next output
+  std::string                           m_line;
+  std::unique_ptr<Writer>               m_writer;
+};
+
+}  // namespace Private
+
+}  // namespace Term
@@ -0,0 +1,53 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#include "cpp-terminal/private/screen_size.hpp"
+
+#ifdef _WIN32
+  #pragma warning(push)
+  #pragma warning(disable : 4668)
+  #define WIN32_LEAN_AND_MEAN
+  #include <windows.h>
+  #pragma warning(pop)
+#else
+  #include <sys/ioctl.h>
+#endif
+
+#include "cpp-terminal/private/file.hpp"
+
+std::atomic<std::uint32_t> Term::Private::ScreenSize::m_size{0};
+
+Term::Screen Term::Private::ScreenSize::get()
+{
+  const std::uint32_t size{m_size.load(std::memory_order_relaxed)};
+  if(size != 0) return Term::Screen({Term::Rows(static_cast<std::uint16_t>(size >> 16)), Term::Columns(static_cast<std::uint16_t>(size & 0xFFFF))});
+  return query();
+}
+
+Term::Screen Term::Private::ScreenSize::query()
+{
+#ifdef _WIN32
+  CONSOLE_SCREEN_BUFFER_INFO inf;
+  if(GetConsoleScreenBufferInfo(Private::out.handle(), &inf)) return Term::Screen({Term::Rows(inf.srWindow.Bottom - inf.srWindow.Top + 1), Term::Columns(inf.srWindow.Right - inf.srWindow.Left + 1)});
+  return {};
+#else
+  struct winsize window{0, 0, 0, 0};
+  if(ioctl(Private::out.fd(), TIOCGWINSZ, &window) != -1) return Term::Screen({Term::Rows(window.ws_row), Term::Columns(window.ws_col)});
+  return {};
+#endif
+}
+
+Term::Screen Term::Private::ScreenSize::update()
+{
+  const Term::Screen screen{query()};
+  m_size.store(static_cast<std::uint32_t>(static_cast<std::uint16_t>(screen.rows())) << 16 | static_cast<std::uint16_t>(screen.columns()), std::memory_order_relaxed);
+  return screen;
+}
+
+void Term::Private::ScreenSize::invalidate() noexcept { m_size.store(0, std::memory_order_relaxed); }
@@ -0,0 +1,57 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include "cpp-terminal/screen.hpp"
+
+#include <atomic>
+#include <cstdint>
+
+namespace Term
+{
+
+namespace Private
+{
+
+///
+///@brief Terminal size, cached while the input thread keeps it up to date.
+///
+///The input thread stores the size when it starts and on each resize so Term::screen_size() is a simple load instead of a system call. The cache is emptied when no one watches the resizes anymore and during a debounced resize, get() then asks the terminal.
+///
+class ScreenSize
+{
+public:
+  ///
+  ///@brief Cached size, or the one given by the terminal if none is cached.
+  ///
+  static Term::Screen get();
+
+  ///
+  ///@brief Ask the size to the terminal.
+  ///
+  static Term::Screen query();
+
+  ///
+  ///@brief Ask the size to the terminal and cache it.
+  ///
+  static Term::Screen update();
+
+  ///
+  ///@brief Empty the cache.
+  ///
+  static void invalidate() noexcept;
+
+private:
+  static std::atomic<std::uint32_t> m_size;  // rows << 16 | columns, 0 if not cached
+};
+
+}  // namespace Private
+
+}  // namespace Term
@@ -0,0 +1,153 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#include "cpp-terminal/session.hpp"
+
+#include "cpp-terminal/exception.hpp"
+#include "cpp-terminal/private/exception.hpp"
+#include "cpp-terminal/private/file.hpp"
+
+#if !defined(_WIN32)
+  #include <cerrno>
+  #include <climits>
+  #include <poll.h>
+  #include <sys/ioctl.h>
+  #include <termios.h>
+  #include <unistd.h>
+#endif
+
+#include <algorithm>
+
+struct Term::Session::Settings
+{
+#if !defined(_WIN32)
+  ::termios original{};
+#endif
+};
+
+Term::Session::Session(const std::int32_t& input, const std::int32_t& output)
+{
+#if defined(_WIN32)
+  static_cast<void>(input);
+  static_cast<void>(output);
+  throw Term::Exception("Term::Session is not supported on Windows");
+#else
+  m_input  = std::unique_ptr<Term::Private::InputFileHandler>(new Term::Private::InputFileHandler(m_mutex, input));
+  m_output = std::unique_ptr<Term::Private::OutputFileHandler>(new Term::Private::OutputFileHandler(m_mutex, output));
+#endif
+}
+
+Term::Session::~Session()
+{
+  try
+  {
+    setRaw(false);
+  }
+  catch(...)
+  {
+    ExceptionHandler(Private::ExceptionDestination::StdErr);
+  }
+}
+
+std::int32_t Term::Session::inputFd() const noexcept { return m_input->fd(); }
+
+std::int32_t Term::Session::outputFd() const noexcept { return m_output->fd(); }
+
+std::size_t Term::Session::write(const std::string& str) const { return m_output->write(str); }
+
+std::size_t Term::Session::write(const std::vector<std::reference_wrapper<const std::string>>& buffers) const { return m_output->write(buffers); }
+
+Term::Event Term::Session::read(const std::chrono::milliseconds& timeout)
+{
+#if defined(_WIN32)
+  static_cast<void>(timeout);
+  return {};
+#else
+  if(!m_connected) return {};
+  ::pollfd  pfd{m_input->fd(), POLLIN, 0};
+  const int wait{timeout == std::chrono::milliseconds::max() ? -1 : static_cast<int>(std::min<std::chrono::milliseconds::rep>(std::max<std::chrono::milliseconds::rep>(timeout.count(), 0), INT_MAX))};
+  int       ret{0};
+  do {
+    ret = ::poll(&pfd, 1, wait);
+  } while(ret == -1 && errno == EINTR);
+  if(ret == -1) { throw Term::Private::ErrnoException(errno, "::poll(&pfd, 1, wait)"); }
+  if(ret == 0) return {};
+  if((pfd.revents & POLLIN) != 0)  //NOLINT(hicpp-signed-bitwise)
+  {
+    try
+    {
+      if(m_input->read(m_buffer) != 0)
+      {
+        Term::Event event(m_buffer);
+        if(event.get_if_mouse() != nullptr) { *event.get_if_mouse() = m_input->mouse().decode(*event.get_if_mouse()); }
+        return event;
+      }
+    }
+    catch(const Term::Exception&)
+    {
+      if((pfd.revents & POLLHUP) == 0) throw;  //NOLINT(hicpp-signed-bitwise)
+    }
+    // Nothing to read after all (non-blocking descriptor emptied by another reader...), still connected.
+    if(!m_input->eof() && (pfd.revents & POLLHUP) == 0) return {};  //NOLINT(hicpp-signed-bitwise)
+  }
+  // End of the input or hung up: the other side has closed the connection.
+  m_connected = false;
+  return {};
+#endif
+}
+
+bool Term::Session::connected() const noexcept { return m_connected; }
+
+void Term::Session::setRaw(const bool& raw)
+{
+#if defined(_WIN32)
+  static_cast<void>(raw);
+#else
+  if(!m_input || ::isatty(m_input->fd()) == 0) return;
+  if(raw)
+  {
+    if(!m_settings)
+    {
+      std::unique_ptr<Settings> settings(new Settings);
+      Term::Private::Errno().check_if(::tcgetattr(m_input->fd(), &settings->original) == -1).throw_exception("::tcgetattr(m_input->fd(), &settings->original)");
+      m_settings = std::move(settings);
+    }
+    ::termios send = m_settings->original;
+    send.c_cflag &= ~static_cast<std::size_t>(CSIZE | PARENB);
+    send.c_cflag |= CS8;
+    send.c_iflag &= ~static_cast<std::size_t>(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | INPCK);
+    send.c_lflag &= ~static_cast<std::size_t>(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+    send.c_cc[VMIN]  = 1;
+    send.c_cc[VTIME] = 0;
+    Term::Private::Errno().check_if(::tcsetattr(m_input->fd(), TCSAFLUSH, &send) == -1).throw_exception("::tcsetattr(m_input->fd(), TCSAFLUSH, &send)");
+  }
+  else if(m_settings)
+  {
+    Term::Private::Errno().check_if(::tcsetattr(m_input->fd(), TCSAFLUSH, &m_settings->original) == -1).throw_exception("::tcsetattr(m_input->fd(), TCSAFLUSH, &m_settings->original)");
+    m_settings.reset();
+  }
+#endif
+}
+
+Term::Screen Term::Session::screen() const
+{
+#if defined(_WIN32)
+  return {};
+#else
+  struct winsize window{0, 0, 0, 0};
+  if(::ioctl(m_output->fd(), TIOCGWINSZ, &window) != -1) return Term::Screen({Term::Rows(window.ws_row), Term::Columns(window.ws_col)});  //NOLINT(cppcoreguidelines-pro-type-vararg,hicpp-vararg)
+  return {};
+#endif
+}
+
+void Term::Session::setOutputMode(const Term::OutputMode& mode, const std::chrono::milliseconds& timeout) { m_output->setMode(mode, timeout); }
+
+Term::OutputStats Term::Session::outputStats() const noexcept { return m_output->stats(); }
+
+Term::OutputBacklog Term::Session::outputBacklog() const { return m_output->backlog(); }
@@ -0,0 +1,125 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#include "cpp-terminal/private/writer.hpp"
+
+#include "cpp-terminal/private/exception.hpp"
+
+Term::Private::Writer::Writer(const std::function<void(const std::string&)>& sink, const std::uint64_t& committed_frame) : m_sink(sink), m_committed_frame(committed_frame), m_written_frame(committed_frame)
+{
+  std::thread thread(&Term::Private::Writer::run, this);
+  m_thread.swap(thread);
+}
+
+Term::Private::Writer::~Writer() noexcept
+{
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_stop = true;
+  }
+  m_work.notify_one();
+  if(m_thread.joinable()) m_thread.join();
+}
+
+void Term::Private::Writer::write(const std::string& data)
+{
+  if(data.empty()) return;
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending += data;
+  }
+  m_work.notify_one();
+}
+
+void Term::Private::Writer::write(const std::vector<std::reference_wrapper<const std::string>>& buffers)
+{
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    for(const std::string& buffer: buffers) { m_pending += buffer; }
+  }
+  m_work.notify_one();
+}
+
+void Term::Private::Writer::write(const std::string& prefix, const char* data, const std::size_t& size)
+{
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending += prefix;
+    m_pending.append(data, size);
+  }
+  m_work.notify_one();
+}
+
+Term::Private::Writer::FrameStatus Term::Private::Writer::writeFrame(std::string&& frame, const std::uint64_t& id, const std::uint64_t& base)
+{
+  FrameStatus status{FrameStatus::Queued};
+  {
+    const std::lock_guard<std::mutex> lock(m_mutex);
+    if(base != 0 && base != m_committed_frame.load()) return FrameStatus::Stale;
+    if(m_frame_id != 0) status = FrameStatus::Replaced;
+    m_frame        = std::move(frame);
+    m_frame_offset = m_pending.size();
+    m_frame_id     = id;
+  }
+  m_work.notify_one();
+  return status;
+}
+
+std::uint64_t Term::Private::Writer::committedFrame() const noexcept { return m_committed_frame.load(); }
+
+std::uint64_t Term::Private::Writer::writtenFrame() const noexcept { return m_written_frame.load(); }
+
+void Term::Private::Writer::drain()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_drained.wait(lock, [this]() { return m_pending.empty() && m_frame_id == 0 && !m_busy; });
+}
+
+std::size_t Term::Private::Writer::pending()
+{
+  const std::lock_guard<std::mutex> lock(m_mutex);
+  return m_pending.size() + (m_frame_id != 0 ? m_frame.size() : 0) + (m_busy ? m_writing_size : 0);
+}
+
+void Term::Private::Writer::run()
+{
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while(true)
+  {
+    m_work.wait(lock, [this]() { return !m_pending.empty() || m_frame_id != 0 || m_stop; });
+    if(m_pending.empty() && m_frame_id == 0) break;
+    const std::uint64_t frame_id{m_frame_id};
+    if(frame_id == 0) { m_pending.swap(m_writing); }
+    else
+    {
+      m_writing.append(m_pending, 0, m_frame_offset);
+      m_writing += m_frame;
+      m_writing.append(m_pending, m_frame_offset, std::string::npos);
+      m_pending.clear();
+      m_frame_id = 0;
+      m_committed_frame.store(frame_id);
+    }
+    m_busy         = true;
+    m_writing_size = m_writing.size();
+    lock.unlock();
+    try
+    {
+      m_sink(m_writing);
+    }
+    catch(...)
+    {
+      ExceptionHandler(ExceptionDestination::StdErr);
+    }
+    m_writing.clear();
+    if(frame_id != 0) { m_written_frame.store(frame_id); }
+    lock.lock();
+    m_busy = false;
+    if(m_pending.empty() && m_frame_id == 0) { m_drained.notify_all(); }
+  }
+}
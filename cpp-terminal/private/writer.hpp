@@ -0,0 +1,120 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Term
+{
+
+namespace Private
+{
+
+///
+///@brief Background thread writing the data handed to it.
+///
+///Double buffered: producers append to the pending buffer and return at once while the thread writes the other buffer, the buffers are swapped each time the thread is done. Their capacity is kept so a steady output doesn't allocate.
+///
+///Frames are written at their place in the output but only the latest pending one is kept: when the terminal is slower than the frames are produced the intermediate ones are dropped instead of piling up.
+///
+class Writer
+{
+public:
+  ///
+  ///@brief What became of a frame handed to writeFrame().
+  ///
+  enum class FrameStatus : std::uint8_t
+  {
+    Queued,
+    Replaced,  ///< Queued in place of a pending frame, which will never be written.
+    Stale,     ///< Not queued, its base isn't the committed frame anymore.
+  };
+
+  ///
+  ///@param sink : Called from the writer thread to actually write the data.
+  ///@param committed_frame : Id of the last frame already written to the terminal, the base of the first frame.
+  ///
+  explicit Writer(const std::function<void(const std::string&)>& sink, const std::uint64_t& committed_frame = 0);
+  Writer(const Writer&)            = delete;
+  Writer(Writer&&)                 = delete;
+  Writer& operator=(const Writer&) = delete;
+  Writer& operator=(Writer&&)      = delete;
+  ///
+  ///@brief Write what is pending and join the thread.
+  ///
+  ~Writer() noexcept;
+
+  ///
+  ///@brief Queue \b data to be written.
+  ///
+  void write(const std::string& data);
+  void write(const std::vector<std::reference_wrapper<const std::string>>& buffers);
+  ///
+  ///@brief Queue \b prefix immediately followed by \b size bytes of \b data.
+  ///
+  void write(const std::string& prefix, const char* data, const std::size_t& size);
+
+  ///
+  ///@brief Queue the frame \b id, replacing the frame still waiting to be written if any.
+  ///
+  ///@param base : Id of the frame \b frame is a diff against, 0 for a full redraw. Checked against the committed frame under the lock, it can't be committed in between.
+  ///
+  FrameStatus writeFrame(std::string&& frame, const std::uint64_t& id, const std::uint64_t& base = 0);
+
+  ///
+  ///@brief Id of the last frame taken by the thread, 0 if none. It can't be replaced anymore and the frames queued afterwards are written after it.
+  ///
+  std::uint64_t committedFrame() const noexcept;
+
+  ///
+  ///@brief Id of the last frame written, 0 if none.
+  ///
+  std::uint64_t writtenFrame() const noexcept;
+
+  ///
+  ///@brief Wait until all the queued data has been written.
+  ///
+  void drain();
+
+  ///
+  ///@brief Number of bytes queued or being written.
+  ///
+  std::size_t pending();
+
+private:
+  void                                    run();
+  std::function<void(const std::string&)> m_sink;
+  std::mutex                              m_mutex;
+  std::condition_variable                 m_work;
+  std::condition_variable                 m_drained;
+  std::string                             m_pending;          // filled by the producers
+  std::string                             m_writing;          // written by the thread
+  std::string                             m_frame;            // latest frame not written yet
+  std::size_t                             m_frame_offset{0};  // position of m_frame in m_pending
+  std::uint64_t                           m_frame_id{0};      // 0 if no frame is pending
+  std::atomic<std::uint64_t>              m_committed_frame{0};
+  std::atomic<std::uint64_t>              m_written_frame{0};
+  std::size_t                             m_writing_size{0};  // size of m_writing while m_busy
+  bool                                    m_busy{false};
+  bool                                    m_stop{false};
+  std::thread                             m_thread;
+};
+
+}  // namespace Private
+
+}  // namespace Term
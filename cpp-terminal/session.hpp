@@ -0,0 +1,108 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#pragma once
+
+#include "cpp-terminal/event.hpp"
+#include "cpp-terminal/output.hpp"
+#include "cpp-terminal/screen.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Term
+{
+
+namespace Private
+{
+class InputFileHandler;
+class OutputFileHandler;
+}  // namespace Private
+
+///
+/// @brief A terminal session over a pair of file descriptors (pty, socket...) instead of the controlling terminal of the process.
+///
+/// Term::cout, Term::cin, Term::terminal and the event functions stay bound to the controlling terminal. A Session gives the same building blocks (complete writes, events, raw mode, size) for another terminal so one process can serve many users, one Session each, without forking. The file descriptors are duplicated: the caller keeps the ownership of the ones it gives. A Session must be used by one thread at a time, different sessions can be used concurrently.
+///
+/// @warning Not supported on Windows, the constructor throws.
+///
+class Session
+{
+public:
+  ///
+  /// @brief Create a session reading from \b input and writing to \b output (can be the same file descriptor).
+  ///
+  Session(const std::int32_t& input, const std::int32_t& output);
+  Session(const Session&)            = delete;
+  Session(Session&&)                 = delete;
+  Session& operator=(const Session&) = delete;
+  Session& operator=(Session&&)      = delete;
+  ~Session();
+
+  std::int32_t inputFd() const noexcept;
+  std::int32_t outputFd() const noexcept;
+
+  ///
+  /// @brief Write \b str completely, see Term::set_output_mode() for the non-blocking mode.
+  ///
+  std::size_t write(const std::string& str) const;
+
+  ///
+  /// @brief Write several buffers in order with a single system call.
+  ///
+  std::size_t write(const std::vector<std::reference_wrapper<const std::string>>& buffers) const;
+
+  ///
+  /// @brief Wait up to \b timeout for input and return it as an event (Key, Mouse, copy-paste...).
+  ///
+  /// @return An empty event on timeout or once the other side has closed the connection (see connected()).
+  ///
+  Term::Event read(const std::chrono::milliseconds& timeout = std::chrono::milliseconds::max());
+
+  ///
+  /// @brief \b false once the other side has closed the connection.
+  ///
+  bool connected() const noexcept;
+
+  ///
+  /// @brief Set the terminal in raw mode (no echo, no line editing, no signal keys), only meaningful for ttys. The original settings are restored by setRaw(false) and by the destructor.
+  ///
+  void setRaw(const bool& raw);
+
+  ///
+  /// @brief Size of the terminal, an empty Screen if the output is not a tty (for a socket the size comes from the protocol used).
+  ///
+  Term::Screen screen() const;
+
+  ///
+  /// @brief See Term::set_output_mode().
+  ///
+  /// @warning The non-blocking flag belongs to the file description, the caller's \b output descriptor shares it while the session exists. The original flags are restored when the session is destroyed.
+  ///
+  void                setOutputMode(const Term::OutputMode& mode, const std::chrono::milliseconds& timeout = std::chrono::milliseconds(5000));
+  Term::OutputStats   outputStats() const noexcept;
+  Term::OutputBacklog outputBacklog() const;
+
+private:
+  struct Settings;
+  std::recursive_mutex                              m_mutex;
+  std::unique_ptr<Term::Private::InputFileHandler>  m_input;
+  std::unique_ptr<Term::Private::OutputFileHandler> m_output;
+  std::unique_ptr<Settings>                         m_settings;  // termios to restore
+  std::string                                       m_buffer;
+  bool                                              m_connected{true};
+};
+
+}  // namespace Term
@@ -18,3 +18,9 @@ std::streambuf* Term::TIstream::rdbuf() const { return const_cast<Term::Buffer*>
 Term::TOstream::TOstream(const Term::Buffer::Type& type, const std::streamsize& size) : m_buffer(type, size), m_stream(&m_buffer) {}
 
 Term::TOstream::~TOstream() { m_stream.flush(); }
+
+void Term::TOstream::setFlushPolicy(const std::size_t& size, const std::chrono::microseconds& interval) { m_buffer.setFlushPolicy(size, interval); }
+
+void Term::TOstream::beginFrame() { m_buffer.beginFrame(); }
+
+void Term::TOstream::endFrame() { m_buffer.endFrame(); }
@@ -57,6 +57,9 @@ public:
     m_stream << t;
     return *this;
   }
+  void setFlushPolicy(const std::size_t& size, const std::chrono::microseconds& interval = std::chrono::microseconds(0));
+  void beginFrame();
+  void endFrame();
 
 private:
   Term::Buffer m_buffer;
@@ -10,12 +10,31 @@
 #include "cpp-terminal/terminal_impl.hpp"
 
 #include "cpp-terminal/cursor.hpp"
+#include "cpp-terminal/input.hpp"
 #include "cpp-terminal/options.hpp"
 #include "cpp-terminal/private/exception.hpp"
 #include "cpp-terminal/private/file.hpp"
 #include "cpp-terminal/screen.hpp"
 #include "cpp-terminal/style.hpp"
 
+namespace
+{
+// Write from the caller's thread while the object lives, then go back to the previous setting (clean() can be interrupted by a signal running clean() too).
+class DirectOutput
+{
+public:
+  DirectOutput() noexcept : m_previous(Term::Private::out.setDirect(true)) {}
+  DirectOutput(const DirectOutput&)            = delete;
+  DirectOutput(DirectOutput&&)                 = delete;
+  DirectOutput& operator=(const DirectOutput&) = delete;
+  DirectOutput& operator=(DirectOutput&&)      = delete;
+  ~DirectOutput() noexcept { Term::Private::out.setDirect(m_previous); }
+
+private:
+  bool m_previous{false};
+};
+}  // namespace
+
 std::string Term::Terminal::clear() const noexcept { return "\u001b[3J"; }
 
 Term::Options Term::Terminal::getOptions() const noexcept { return m_options; }
@@ -43,6 +62,9 @@ Term::Terminal::~Terminal() noexcept
 {
   try
   {
+    // Not in clean() which also runs in the signal handlers.
+    Term::stop_reading();
+    Term::Private::out.drain();  // The asynchronous output before the restore sequences.
     clean();
   }
   catch(...)
@@ -57,6 +79,8 @@ Term::Terminal::~Terminal() noexcept
 
 void Term::Terminal::clean()
 {
+  // Also called from the signal handlers, fatal or not: the background writer may hold its lock and would never write what is queued after a fatal signal.
+  const DirectOutput direct;
   unsetFocusEvents();
   unsetMouseEvents();
   if(getOptions().has(Option::NoCursor)) { Term::Private::out.write(cursor_on()); }
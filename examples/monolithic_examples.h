@@ -24,6 +24,7 @@ extern "C" {
 	int cppterminal_menu_example_main(void);
 	int cppterminal_menu_window_example_main(void);
 	int cppterminal_minimal_example_main(void);
+	int cppterminal_output_benchmark_example_main(void);
 	int cppterminal_prompt_immediate_example_main(void);
 	int cppterminal_prompt_multiline_example_main(void);
 	int cppterminal_prompt_not_immediate_example_main(void);
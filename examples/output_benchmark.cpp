@@ -0,0 +1,86 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#include "cpp-terminal/cursor.hpp"
+#include "cpp-terminal/exception.hpp"
+#include "cpp-terminal/iostream.hpp"
+#include "cpp-terminal/options.hpp"
+#include "cpp-terminal/output.hpp"
+#include "cpp-terminal/screen.hpp"
+#include "cpp-terminal/terminal.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <string>
+
+#include "monolithic_examples.h"
+
+#if defined(BUILD_MONOLITHIC)
+#define main			cppterminal_output_benchmark_example_main
+#endif
+
+namespace
+{
+
+// A full screen frame, different for each index.
+std::string make_frame(const Term::Screen& screen, const std::size_t& index)
+{
+  std::string frame{Term::cursor_move(1, 1)};
+  for(std::size_t row = 0; row != screen.rows(); ++row)
+  {
+    std::string line(screen.columns(), static_cast<char>('a' + (index + row) % 26));
+    frame += line;
+    if(row + 1 != screen.rows()) frame += "\r\n";
+  }
+  return frame;
+}
+
+double run(const Term::OutputMode& mode, const std::size_t& frames)
+{
+  Term::set_output_mode(mode);
+  const Term::Screen                          screen{Term::screen_size()};
+  const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+  std::size_t                                 bytes{0};
+  for(std::size_t i = 0; i != frames; ++i)
+  {
+    const std::string frame{make_frame(screen, i)};
+    bytes += Term::write_output({frame});
+  }
+  const std::chrono::duration<double> elapsed{std::chrono::steady_clock::now() - start};
+  Term::set_output_mode(Term::OutputMode::Blocking);
+  return static_cast<double>(bytes) / elapsed.count() / 1024.0 / 1024.0;
+}
+
+}  // namespace
+
+int main(void)
+{
+  try
+  {
+    Term::terminal.setOptions(Term::Option::ClearScreen, Term::Option::NoSignalKeys, Term::Option::Cursor, Term::Option::Raw);
+    const std::size_t frames{500};
+    const double      blocking{run(Term::OutputMode::Blocking, frames)};
+    const double      non_blocking{run(Term::OutputMode::NonBlocking, frames)};
+    Term::cout << Term::clear_screen() << Term::cursor_move(1, 1) << frames << " full screen frames written:\r\n";
+    Term::cout << "  blocking     : " << blocking << " MiB/s\r\n";
+    Term::cout << "  non-blocking : " << non_blocking << " MiB/s\r\n" << std::flush;
+  }
+  catch(const Term::Exception& re)
+  {
+    Term::cerr << "cpp-terminal error: " << re.what() << std::endl;
+    return 2;
+  }
+  catch(...)
+  {
+    Term::cerr << "There was an exception!" << std::endl;
+    return 1;
+  }
+  return 0;
+}
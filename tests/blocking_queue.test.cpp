@@ -0,0 +1,213 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#if !defined(BUILD_MONOLITHIC)
+  #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#endif
+#include "cpp-terminal/private/blocking_queue.hpp"
+
+#include "doctest/doctest.h"
+
+#include <atomic>
+#include <thread>
+
+#if !defined(_WIN32)
+  #include <poll.h>
+#endif
+
+TEST_CASE("Mouse motion coalescing")
+{
+  Term::Private::BlockingQueue queue;
+  queue.push(Term::Mouse(Term::Button(Term::Button::Type::None, Term::Button::Action::None), 1, 1));
+  queue.push(Term::Mouse(Term::Button(Term::Button::Type::None, Term::Button::Action::None), 1, 2));
+  CHECK(queue.size() == 2);
+  queue.set_motion_coalescing(true);
+  queue.push(Term::Mouse(Term::Button(Term::Button::Type::None, Term::Button::Action::None), 1, 3));
+  queue.push(Term::Mouse(Term::Button(Term::Button::Type::None, Term::Button::Action::None), 1, 4));
+  CHECK(queue.size() == 2);
+  queue.push(Term::Mouse(Term::Button(Term::Button::Type::Left, Term::Button::Action::Pressed), 1, 4));
+  queue.push(Term::Mouse(Term::Button(Term::Button::Type::Left, Term::Button::Action::None), 1, 5));
+  queue.push(Term::Mouse(Term::Button(Term::Button::Type::Left, Term::Button::Action::None), 2, 5));
+  queue.push(Term::Mouse(Term::Button(Term::Button::Type::None, Term::Button::Action::None), 3, 5));
+  CHECK(queue.size() == 5);
+  CHECK(queue.pop().get_if_mouse()->column() == 1);
+  CHECK(queue.pop().get_if_mouse()->column() == 4);
+  CHECK(queue.pop().get_if_mouse()->getButton().action() == Term::Button::Action::Pressed);
+  CHECK(queue.pop().get_if_mouse()->row() == 2);
+  CHECK(queue.pop().get_if_mouse()->row() == 3);
+  CHECK(queue.empty());
+}
+
+TEST_CASE("Key repeats")
+{
+  Term::Private::BlockingQueue queue;
+  queue.push(Term::Key(Term::Key::Value::ArrowDown), 3);
+  queue.push(Term::Key(Term::Key::Value::ArrowDown));
+  queue.push(Term::Key(Term::Key::Value::ArrowUp));
+  CHECK(queue.size() == 5);
+  for(std::size_t i = 0; i != 4; ++i)
+  {
+    const Term::Event event{queue.pop()};
+    CHECK(event == Term::Key(Term::Key::Value::ArrowDown));
+    CHECK(event.repeat() == 1);
+  }
+  CHECK(queue.pop() == Term::Key(Term::Key::Value::ArrowUp));
+  CHECK(queue.empty());
+  queue.set_repeat_coalescing(true);
+  queue.push(Term::Key(Term::Key::Value::ArrowDown));
+  queue.push(Term::Key(Term::Key::Value::ArrowDown), 39);
+  queue.push(Term::Key(Term::Key::Value::Enter));
+  CHECK(queue.size() == 2);
+  const Term::Event event{queue.pop()};
+  CHECK(event == Term::Key(Term::Key::Value::ArrowDown));
+  CHECK(event.repeat() == 40);
+  CHECK(queue.pop().repeat() == 1);
+  CHECK(queue.empty());
+}
+
+TEST_CASE("Resize and focus priority lane")
+{
+  Term::Private::BlockingQueue queue;
+  queue.push(Term::Key(Term::Key::Value::a));
+  queue.push(Term::Screen({Term::Rows(10), Term::Columns(20)}));
+  queue.push(Term::Focus(Term::Focus::Type::Out));
+  queue.push(Term::Key(Term::Key::Value::b));
+  queue.push(Term::Screen({Term::Rows(30), Term::Columns(40)}));
+  queue.push(Term::Focus(Term::Focus::Type::In));
+  CHECK(queue.size() == 4);
+  const Term::Event screen{queue.pop()};
+  REQUIRE(screen.get_if_screen() != nullptr);
+  CHECK(screen.get_if_screen()->rows() == 30);
+  CHECK(screen.get_if_screen()->columns() == 40);
+  const Term::Event focus{queue.pop()};
+  REQUIRE(focus.get_if_focus() != nullptr);
+  CHECK(focus.get_if_focus()->type() == Term::Focus::Type::In);
+  CHECK(queue.pop() == Term::Key(Term::Key::Value::a));
+  CHECK(queue.pop() == Term::Key(Term::Key::Value::b));
+  CHECK(queue.empty());
+}
+
+TEST_CASE("Bounded queue")
+{
+  const Term::Mouse motion(Term::Button(Term::Button::Type::None, Term::Button::Action::None), 1, 1);
+  Term::Private::BlockingQueue queue;
+  queue.set_capacity(2, Term::OverflowPolicy::DropNewest);
+  queue.push(Term::Key(Term::Key::Value::a));
+  queue.push(Term::Key(Term::Key::Value::b));
+  queue.push(Term::Key(Term::Key::Value::c));
+  queue.push(Term::Key(Term::Key::Value::b), 5);
+  queue.push(Term::Screen({Term::Rows(10), Term::Columns(20)}));
+  CHECK(queue.size() == 8);
+  CHECK(queue.overflows() == 1);
+  while(!queue.empty()) { CHECK(queue.pop() != Term::Key(Term::Key::Value::c)); }
+
+  queue.set_capacity(3, Term::OverflowPolicy::DropOldestMotion);
+  queue.push(Term::Key(Term::Key::Value::a));
+  queue.push(motion);
+  queue.push(Term::Key(Term::Key::Value::b));
+  queue.push(Term::Key(Term::Key::Value::c));
+  queue.push(Term::Key(Term::Key::Value::d));
+  CHECK(queue.overflows() == 3);
+  CHECK(queue.pop() == Term::Key(Term::Key::Value::a));
+  CHECK(queue.pop() == Term::Key(Term::Key::Value::b));
+  CHECK(queue.pop() == Term::Key(Term::Key::Value::c));
+  CHECK(queue.empty());
+
+  queue.set_capacity(1, Term::OverflowPolicy::Block);
+  queue.push(Term::Key(Term::Key::Value::a));
+  std::thread producer([&queue]() { queue.push(Term::Key(Term::Key::Value::b)); });
+  // The wait is counted under the lock the producer then waits on.
+  while(queue.waits() != 1) { std::this_thread::yield(); }
+  CHECK(queue.pop(std::chrono::milliseconds::max()) == Term::Key(Term::Key::Value::a));
+  CHECK(queue.pop(std::chrono::milliseconds::max()) == Term::Key(Term::Key::Value::b));
+  producer.join();
+  CHECK(queue.overflows() == 3);
+  CHECK(queue.waits() == 1);
+  queue.push(Term::Key(Term::Key::Value::a));
+  queue.interrupt(true);
+  queue.push(Term::Key(Term::Key::Value::b));
+  queue.interrupt(false);
+  CHECK(queue.size() == 1);
+  CHECK(queue.overflows() == 4);
+  CHECK(queue.waits() == 1);
+}
+
+TEST_CASE("Read several events at once")
+{
+  Term::Private::BlockingQueue queue;
+  std::vector<Term::Event>     events;
+  CHECK(queue.pop(events, 10, std::chrono::milliseconds(10)) == 0);
+  queue.push(Term::Key(Term::Key::Value::a));
+  queue.push(Term::Key(Term::Key::Value::b));
+  queue.push(Term::Key(Term::Key::Value::c));
+  CHECK(queue.pop(events, 2, std::chrono::milliseconds::max()) == 2);
+  CHECK(queue.pop(events, 2, std::chrono::milliseconds::zero()) == 1);
+  CHECK(queue.empty());
+  REQUIRE(events.size() == 3);
+  CHECK(*events[0].get_if_key() == Term::Key::Value::a);
+  CHECK(*events[1].get_if_key() == Term::Key::Value::b);
+  CHECK(*events[2].get_if_key() == Term::Key::Value::c);
+}
+
+TEST_CASE("Queue keeps the order while growing")
+{
+  Term::Private::BlockingQueue queue;
+  for(std::int32_t i = 0; i != 100; ++i) { queue.push(Term::Key(i)); }
+  CHECK(queue.pop() == Term::Key(0));
+  for(std::int32_t i = 100; i != 300; ++i) { queue.push(Term::Key(i)); }
+  CHECK(queue.size() == 299);
+  for(std::int32_t i = 1; i != 300; ++i) { CHECK(queue.pop() == Term::Key(i)); }
+  CHECK(queue.empty());
+  CHECK(queue.pop().empty());
+}
+
+TEST_CASE("Timed and non-blocking reads")
+{
+  Term::Private::BlockingQueue queue;
+  CHECK(queue.pop().empty());
+  CHECK(queue.pop(std::chrono::milliseconds(10)).empty());
+  std::thread producer(
+    [&queue]()
+    {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+      queue.push(Term::Key(Term::Key::Value::a));
+      queue.push(Term::Key(Term::Key::Value::b));
+    });
+  std::atomic<std::size_t> received{0};
+  std::thread              consumer(
+    [&queue, &received]()
+    {
+      if(!queue.pop(std::chrono::milliseconds::max()).empty()) ++received;
+    });
+  if(!queue.pop(std::chrono::milliseconds::max()).empty()) ++received;
+  producer.join();
+  consumer.join();
+  CHECK(received == 2);
+  CHECK(queue.empty());
+}
+
+#if !defined(_WIN32)
+TEST_CASE("Readiness file descriptor")
+{
+  Term::Private::BlockingQueue queue;
+  queue.push(Term::Key(Term::Key::Value::a));
+  const std::int32_t fd{queue.ready_fd()};
+  REQUIRE(fd != -1);
+  ::pollfd poll_fd{fd, POLLIN, 0};
+  CHECK(::poll(&poll_fd, 1, 0) == 1);
+  queue.pop();
+  CHECK(::poll(&poll_fd, 1, 0) == 0);
+  queue.push(Term::Key(Term::Key::Value::b));
+  queue.push(Term::Key(Term::Key::Value::c));
+  CHECK(::poll(&poll_fd, 1, 0) == 1);
+  std::vector<Term::Event> events;
+  queue.pop(events, 2, std::chrono::milliseconds::zero());
+  CHECK(::poll(&poll_fd, 1, 0) == 0);
+}
+#endif
@@ -0,0 +1,196 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#if !defined(BUILD_MONOLITHIC)
+  #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#endif
+#include "cpp-terminal/buffer.hpp"
+
+#include "cpp-terminal/output.hpp"
+#include "cpp-terminal/private/file.hpp"
+#include "doctest/doctest.h"
+
+#include <chrono>
+#include <ostream>
+#include <string>
+#include <thread>
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <unistd.h>
+
+namespace
+{
+
+// Redirect what the library writes to the terminal into a pipe.
+class Capture
+{
+public:
+  Capture()
+  {
+    REQUIRE(::pipe(m_pipe) == 0);
+    REQUIRE(::fcntl(m_pipe[0], F_SETFL, O_NONBLOCK) == 0);
+    m_saved = ::dup(Term::Private::out.fd());
+    REQUIRE(::dup2(m_pipe[1], Term::Private::out.fd()) != -1);
+    Term::reset_output_stats();
+  }
+  Capture(const Capture&)            = delete;
+  Capture(Capture&&)                 = delete;
+  Capture& operator=(const Capture&) = delete;
+  Capture& operator=(Capture&&)      = delete;
+  ~Capture()
+  {
+    ::dup2(m_saved, Term::Private::out.fd());
+    ::close(m_saved);
+    ::close(m_pipe[0]);
+    ::close(m_pipe[1]);
+  }
+
+  // What has been written since the last call.
+  std::string take() const
+  {
+    std::string written;
+    char        chunk[4096];
+    for(::ssize_t ret = ::read(m_pipe[0], chunk, sizeof(chunk)); ret > 0; ret = ::read(m_pipe[0], chunk, sizeof(chunk))) { written.append(chunk, static_cast<std::size_t>(ret)); }
+    return written;
+  }
+
+  // Number of writes since the last call.
+  std::uint64_t writes() const
+  {
+    const std::uint64_t writes{Term::output_stats().writes};
+    Term::reset_output_stats();
+    return writes;
+  }
+
+private:
+  int m_pipe[2]{-1, -1};
+  int m_saved{-1};
+};
+
+}  // namespace
+
+TEST_CASE("Unbuffered output")
+{
+  const Capture capture;
+  Term::Buffer  buffer(Term::Buffer::Type::Unbuffered);
+  std::ostream  stream(&buffer);
+  const std::string large(10000, 'l');
+  stream << "ab" << 'c' << large;
+  stream.put('d');
+  // Each insertion is written at once, a string with a single write.
+  CHECK(capture.take() == "abc" + large + "d");
+  CHECK(capture.writes() == 4);
+  stream << "e\nf";
+  CHECK(capture.take() == "e\nf");
+  CHECK(capture.writes() == 1);
+}
+
+TEST_CASE("Line buffered output")
+{
+  const Capture capture;
+  Term::Buffer  buffer(Term::Buffer::Type::LineBuffered, 16);
+  std::ostream  stream(&buffer);
+  stream << "one\ntw";
+  CHECK(capture.take() == "one\n");
+  stream.put('o');
+  stream.put('\n');
+  CHECK(capture.take() == "two\n");
+  // A line longer than the buffer waits for its end.
+  const std::string large(10000, 'l');
+  stream << "three" << large;
+  CHECK(capture.take().empty());
+  stream << "\nfo" << 'u' << "r\nfive";
+  CHECK(capture.take() == "three" + large + "\nfour\n");
+  stream << std::flush;
+  CHECK(capture.take() == "five");
+  CHECK(capture.writes() == 5);
+}
+
+TEST_CASE("Fully buffered output")
+{
+  const Capture capture;
+  Term::Buffer  buffer(Term::Buffer::Type::FullBuffered, 16);
+  std::ostream  stream(&buffer);
+  // The first character creates the put area.
+  stream.put('0');
+  stream << "123456789";
+  CHECK(capture.take().empty());
+  // Not enough room left: the buffer is written and the string starts a new one.
+  stream << "abcdefgh";
+  CHECK(capture.take() == "0123456789");
+  // Characters fill the put area, the one not fitting anymore writes it.
+  for(const char character: std::string("ijklmnop")) { stream.put(character); }
+  CHECK(capture.take().empty());
+  stream.put('q');
+  CHECK(capture.take() == "abcdefghijklmnop");
+  // Bigger than the put area: what is buffered is written first then the string, without copying it.
+  const std::string large(40, 'L');
+  stream << "rs" << large;
+  CHECK(capture.take() == "qrs" + large);
+  stream << "tu" << 'v' << std::flush;
+  CHECK(capture.take() == "tuv");
+  CHECK(capture.writes() == 5);
+  stream << std::flush;
+  CHECK(capture.writes() == 0);
+}
+
+TEST_CASE("Flush policy")
+{
+  const Capture capture;
+  Term::Buffer  buffer(Term::Buffer::Type::FullBuffered);
+  std::ostream  stream(&buffer);
+  // Size threshold only.
+  buffer.setFlushPolicy(32);
+  const std::string sixteen(16, 's');
+  stream << sixteen << sixteen;
+  CHECK(capture.take().empty());
+  stream << "x";
+  CHECK(capture.take() == sixteen + sixteen);
+  stream << std::flush;
+  CHECK(capture.take() == "x");
+  CHECK(capture.writes() == 2);
+  // With an interval the first insertion after an idle period is written at once, the next ones wait for the interval.
+  buffer.setFlushPolicy(1024, std::chrono::milliseconds(100));
+  stream << "first";
+  CHECK(capture.take() == "first");
+  stream << "second";
+  stream << "third";
+  CHECK(capture.take().empty());
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  // Still buffered while the stream is not used.
+  CHECK(capture.take().empty());
+  stream << "fourth";
+  CHECK(capture.take() == "secondthirdfourth");
+  CHECK(capture.writes() == 2);
+}
+
+TEST_CASE("Frames are written whole")
+{
+  const Capture capture;
+  Term::Buffer  buffer(Term::Buffer::Type::FullBuffered, 16);
+  std::ostream  stream(&buffer);
+  stream << "before";
+  buffer.beginFrame();
+  // Neither the size of the buffer nor a flush write a partial frame.
+  const std::string large(100, 'f');
+  stream << large;
+  stream.put('c');
+  stream << std::flush;
+  CHECK(capture.take().empty());
+  buffer.endFrame();
+  CHECK(capture.take() == "before" + large + "c");
+  CHECK(capture.writes() == 1);
+  // Back to the normal size after the frame.
+  stream << "0123456789abcdef" << "g";
+  CHECK(capture.take() == "0123456789abcdef");
+  stream << std::flush;
+  CHECK(capture.take() == "g");
+}
+#endif
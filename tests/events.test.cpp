@@ -11,6 +11,7 @@
 #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
 #endif
 #include "cpp-terminal/event.hpp"
+#include "cpp-terminal/private/mouse_decoder.hpp"
 #include "doctest/doctest.h"
 
 TEST_CASE("default Event")
@@ -24,6 +25,7 @@ TEST_CASE("default Event")
   CHECK(event.get_if_mouse() == nullptr);
   CHECK(event.get_if_copy_paste() == nullptr);
   CHECK(event.type() == Term::Event::Type::Empty);
+  CHECK(event.timestamp() == std::chrono::steady_clock::time_point());
   const Term::Event event2 = event;
   CHECK(event2.empty() == true);
   CHECK(event2.get_if_screen() == nullptr);
@@ -193,3 +195,58 @@ TEST_CASE("Event with CopyPaste")
   CHECK(*event2.get_if_copy_paste() == "toto");
   CHECK(event2.type() == Term::Event::Type::CopyPaste);
 }
+
+TEST_CASE("Event copy and move")
+{
+  CHECK(sizeof(Term::Event) <= 16);
+  Term::Event paste("a copy paste longer than ten characters");
+  Term::Event copy;
+  copy = paste;
+  CHECK(*copy.get_if_copy_paste() == *paste.get_if_copy_paste());
+  copy.get_if_copy_paste()->append("!");
+  CHECK(*paste.get_if_copy_paste() == "a copy paste longer than ten characters");
+  CHECK(*copy.get_if_copy_paste() == "a copy paste longer than ten characters!");
+  copy = Term::Event(Term::Key(Term::Key::Value::Enter));
+  CHECK(copy.type() == Term::Event::Type::Key);
+  CHECK(*copy.get_if_key() == Term::Key::Value::Enter);
+  Term::Event moved(std::move(paste));
+  CHECK(paste.empty() == true);  //NOLINT(bugprone-use-after-move,hicpp-invalid-access-moved)
+  CHECK(*moved.get_if_copy_paste() == "a copy paste longer than ten characters");
+  copy = std::move(moved);
+  CHECK(copy.type() == Term::Event::Type::CopyPaste);
+  CHECK(*copy.get_if_copy_paste() == "a copy paste longer than ten characters");
+}
+
+TEST_CASE("Event from SGR mouse report")
+{
+  Term::Event press("\033[<2;12;345M");
+  CHECK(press.type() == Term::Event::Type::Mouse);
+  CHECK(*press.get_if_mouse() == Term::Mouse(Term::Button(Term::Button::Type::Left, Term::Button::Action::Pressed), 12, 345));
+  Term::Event release("\033[<2;12;345m");
+  CHECK(release.get_if_mouse()->getButton().action() == Term::Button::Action::Released);
+  Term::Event wheel("\033[<65;1;2M");
+  CHECK(*wheel.get_if_mouse() == Term::Mouse(Term::Button(Term::Button::Type::Wheel, Term::Button::Action::RolledDown), 1, 2));
+  // Several reports returned by a single read: the fields stop at the terminator of the first one.
+  Term::Event moves("\033[<35;10;20M\033[<35;11;21M");
+  REQUIRE(moves.get_if_mouse() != nullptr);
+  CHECK(moves.get_if_mouse()->row() == 10);
+  CHECK(moves.get_if_mouse()->column() == 20);
+  Term::Event click("\033[<2;10;20M\033[<2;10;20m");
+  REQUIRE(click.get_if_mouse() != nullptr);
+  CHECK(*click.get_if_mouse() == Term::Mouse(Term::Button(Term::Button::Type::Left, Term::Button::Action::Pressed), 10, 20));
+}
+
+TEST_CASE("Double-click detection")
+{
+  const Term::Mouse                           press(Term::Button(Term::Button::Type::Left, Term::Button::Action::Pressed), 3, 4);
+  const Term::Mouse                           release(Term::Button(Term::Button::Type::Left, Term::Button::Action::Released), 3, 4);
+  const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+  Term::Private::MouseDecoder                 decoder(std::chrono::milliseconds(100));
+  CHECK(decoder.decode(press, start).getButton().action() == Term::Button::Action::Pressed);
+  CHECK(decoder.decode(release, start + std::chrono::milliseconds(10)).getButton().action() == Term::Button::Action::Released);
+  CHECK(decoder.decode(press, start + std::chrono::milliseconds(50)).getButton().action() == Term::Button::Action::DoubleClicked);
+  Term::Private::MouseDecoder other(std::chrono::milliseconds(100));
+  CHECK(other.decode(press, start).getButton().action() == Term::Button::Action::Pressed);
+  CHECK(other.decode(release, start + std::chrono::milliseconds(10)).getButton().action() == Term::Button::Action::Released);
+  CHECK(other.decode(press, start + std::chrono::milliseconds(500)).getButton().action() == Term::Button::Action::Pressed);
+}
@@ -12,9 +12,22 @@
 #endif
 //#include "cpp-terminal/platforms/file.hpp"
 
+#include "cpp-terminal/exception.hpp"
+#include "cpp-terminal/output.hpp"
+#include "cpp-terminal/private/file.hpp"
 #include "doctest/doctest.h"
 
+#include <chrono>
+#include <cmath>
 #include <cstdio>
+#include <mutex>
+#include <string>
+
+#if !defined(_WIN32)
+  #include <sys/socket.h>
+  #include <thread>
+  #include <unistd.h>
+#endif
 
 TEST_CASE("Test platform/file.hpp")
 {
@@ -22,3 +35,201 @@ TEST_CASE("Test platform/file.hpp")
   //Term::Private::out.write("Good !\n");
   //std::fprintf(Term::Private::out.file(), "Good !\n");
 }
+
+TEST_CASE("Output statistics")
+{
+  Term::reset_output_stats();
+  const std::string reset{"\x1b[0m"};  // Harmless if the tests run in a terminal.
+  CHECK(Term::write_output({reset, reset}) == 2 * reset.size());
+  const Term::OutputStats stats = Term::output_stats();
+  CHECK(stats.bytes == 2 * reset.size());
+  CHECK(stats.writes >= 1);
+  CHECK(stats.would_block == 0);
+  Term::reset_output_stats();
+  CHECK(Term::output_stats().bytes == 0);
+  CHECK(Term::output_stats().writes == 0);
+}
+
+TEST_CASE("Output backlog")
+{
+  const Term::OutputBacklog backlog = Term::output_backlog();
+  CHECK(backlog.pending == 0);
+  CHECK(backlog.drain_rate >= 0);
+  Term::OutputBacklog estimated;
+  estimated.queued     = 1000;
+  estimated.pending    = 1000;
+  estimated.drain_rate = 4000;
+  CHECK(estimated.delay() == std::chrono::milliseconds(500));
+  CHECK(Term::OutputBacklog().delay() == std::chrono::milliseconds(0));
+}
+
+TEST_CASE("Drain rate estimate")
+{
+  const std::chrono::steady_clock::time_point start{std::chrono::seconds(1)};
+  const auto                                  at = [&start](const std::int64_t& milliseconds, const std::uint64_t& drained, const std::size_t& queued, const std::uint64_t& waited_bytes, const std::int64_t& waited_time)
+  {
+    Term::Private::DrainSample sample;
+    sample.time         = start + std::chrono::milliseconds(milliseconds);
+    sample.drained      = drained;
+    sample.queued       = queued;
+    sample.waited_bytes = waited_bytes;
+    sample.waited_time  = std::chrono::nanoseconds(std::chrono::milliseconds(waited_time)).count();
+    return sample;
+  };
+  const auto near = [](const double& rate, const double& expected) { return std::abs(rate - expected) < 1e-6 * expected; };
+  // A single sample of the queue gives no rate.
+  Term::Private::DrainSample drain{Term::Private::drain_estimate(Term::Private::DrainSample(), at(0, 0, 1000, 0, 0))};
+  CHECK(drain.rate == 0);
+  // The queue stayed non-empty: 500 bytes left it in 100ms.
+  drain = Term::Private::drain_estimate(drain, at(100, 500, 500, 0, 0));
+  CHECK(near(drain.rate, 5000));
+  // Samples closer than 10ms are ignored.
+  drain = Term::Private::drain_estimate(drain, at(105, 1500, 500, 0, 0));
+  CHECK(near(drain.rate, 5000));
+  // Moving average of the next measure (1000 bytes in 100ms).
+  drain = Term::Private::drain_estimate(drain, at(200, 1500, 600, 0, 0));
+  CHECK(near(drain.rate, 0.75 * 5000 + 0.25 * 10000));
+  // The queue emptied in between, nothing tells how fast: no update.
+  drain = Term::Private::drain_estimate(drain, at(300, 2100, 0, 0, 0));
+  CHECK(near(drain.rate, 6250));
+  // Empty queue (pty): the writes that waited for the terminal, 2000 bytes in 100ms.
+  drain = Term::Private::drain_estimate(drain, at(400, 4100, 0, 2000, 100));
+  CHECK(near(drain.rate, 0.75 * 6250 + 0.25 * 20000));
+  // Less than 10ms of waiting is not enough.
+  drain = Term::Private::drain_estimate(drain, at(500, 4200, 0, 2500, 105));
+  CHECK(near(drain.rate, 9687.5));
+  // The counters went back to 0 (reset_output_stats()): the baseline is reset instead of giving a negative rate.
+  drain = Term::Private::drain_estimate(drain, at(600, 4200, 0, 100, 1));
+  CHECK(near(drain.rate, 9687.5));
+  drain = Term::Private::drain_estimate(drain, at(700, 4300, 0, 1100, 51));
+  CHECK(near(drain.rate, 0.75 * 9687.5 + 0.25 * 20000));
+}
+
+#if !defined(_WIN32)
+TEST_CASE("Input read into a reused buffer")
+{
+  int fds[2]{-1, -1};
+  REQUIRE(::pipe(fds) == 0);
+  {
+    std::recursive_mutex            mutex;
+    Term::Private::InputFileHandler input(mutex, fds[0]);
+    std::string                     buffer;
+    const std::string               paste(20000, 'p');
+    CHECK(::write(fds[1], paste.data(), paste.size()) == static_cast<::ssize_t>(paste.size()));
+    CHECK(input.read(buffer) == paste.size());
+    CHECK(buffer == paste);
+    // The storage grown by the paste is kept, only what is read is exposed.
+    CHECK(::write(fds[1], "k", 1) == 1);
+    CHECK(input.read(buffer) == 1);
+    CHECK(buffer == "k");
+    CHECK(buffer.capacity() >= paste.size());
+  }
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+
+namespace
+{
+// Read \b size bytes from \b fd by small chunks, so the writer keeps finding the socket full.
+std::string read_slowly(const int& fd, const std::size_t& size)
+{
+  std::string received;
+  char        chunk[1024];
+  while(received.size() != size)
+  {
+    const ::ssize_t ret{::read(fd, chunk, sizeof(chunk))};
+    if(ret <= 0) break;
+    received.append(chunk, static_cast<std::size_t>(ret));
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  return received;
+}
+}  // namespace
+
+TEST_CASE("Non-blocking output")
+{
+  int fds[2]{-1, -1};
+  REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  const int size{4096};
+  ::setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+  ::setsockopt(fds[1], SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+  std::string data(256 * 1024, '\0');
+  for(std::size_t i = 0; i != data.size(); ++i) { data[i] = static_cast<char>(i % 251); }
+  const std::string head{data.substr(0, 1000)};
+  const std::string middle{data.substr(1000, 100000)};
+  const std::string tail{data.substr(101000)};
+  {
+    std::recursive_mutex             mutex;
+    Term::Private::OutputFileHandler output(mutex, fds[0]);
+    output.setMode(Term::OutputMode::NonBlocking, std::chrono::milliseconds(5000));
+    // The data arrives complete and in order across the short writes and EAGAIN.
+    std::string received;
+    std::thread reader([&received, &data, &fds]() { received = read_slowly(fds[1], 2 * data.size()); });
+    CHECK(output.write(data) == data.size());
+    CHECK(output.write({head, middle, tail}) == data.size());
+    reader.join();
+    CHECK(received == data + data);
+    CHECK(output.stats().bytes == 2 * data.size());
+    CHECK(output.stats().would_block > 0);
+    CHECK(output.stats().short_writes > 0);
+    // Nobody reads: the write gives up after the timeout.
+    output.setMode(Term::OutputMode::NonBlocking, std::chrono::milliseconds(100));
+    const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+    CHECK_THROWS_AS(output.write(data), Term::Exception);
+    CHECK(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(100));
+    // What has been written before the timeout is dropped, let the next write start on an empty socket.
+    char dropped[1024];
+    while(::recv(fds[1], dropped, sizeof(dropped), MSG_DONTWAIT) > 0) {}
+    // The largest timeout never expires.
+    output.setMode(Term::OutputMode::NonBlocking, std::chrono::milliseconds::max());
+    std::thread late_reader(
+      [&received, &data, &fds]()
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        received = read_slowly(fds[1], data.size());
+      });
+    CHECK(output.write(data) == data.size());
+    late_reader.join();
+    CHECK(received == data);
+  }
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+
+TEST_CASE("Frames diffed against a stale frame")
+{
+  int fds[2]{-1, -1};
+  REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  const int size{4096};
+  ::setsockopt(fds[0], SOL_SOCKET, SO_SNDBUF, &size, sizeof(size));
+  ::setsockopt(fds[1], SOL_SOCKET, SO_RCVBUF, &size, sizeof(size));
+  const std::string large(100000, 'l');
+  std::string       received;
+  {
+    std::recursive_mutex             mutex;
+    Term::Private::OutputFileHandler output(mutex, fds[0]);
+    CHECK(output.writeFrame("a", 0) == 1);
+    CHECK(output.writeFrame("b", 1) == 2);
+    CHECK(output.writeFrame("c", 1) == 0);
+    CHECK(output.committedFrame() == 2);
+    // The background writer starts from the frame written synchronously.
+    output.setAsync(true);
+    const std::uint64_t id{output.writeFrame(std::string(large), 2)};
+    CHECK(id != 0);
+    // Nobody reads: the writer is stuck on the large frame, the next ones replace each other.
+    while(output.committedFrame() != id) { std::this_thread::yield(); }
+    CHECK(output.writeFrame("d", 2) == 0);
+    CHECK(output.writeFrame("e", id) != 0);
+    CHECK(output.writeFrame("f", id) != 0);
+    CHECK(output.stats().replaced_frames == 1);
+    std::thread reader([&received, &large, &fds]() { received = read_slowly(fds[1], 2 + large.size() + 1); });
+    output.drain();
+    reader.join();
+    output.resetStats();
+    CHECK(output.stats().replaced_frames == 0);
+  }
+  CHECK(received == "ab" + large + "f");
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+#endif
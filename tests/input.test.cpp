@@ -0,0 +1,388 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#if !defined(BUILD_MONOLITHIC)
+  #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#endif
+#include "cpp-terminal/input.hpp"
+
+#include "cpp-terminal/exception.hpp"
+#include "cpp-terminal/key.hpp"
+#include "cpp-terminal/options.hpp"
+#include "cpp-terminal/output.hpp"
+#include "cpp-terminal/screen.hpp"
+#include "cpp-terminal/terminal.hpp"
+#include "doctest/doctest.h"
+
+#include <chrono>
+#include <string>
+
+#if defined(__linux__)
+  #include <atomic>
+  #include <csignal>
+  #include <cstdio>
+  #include <cstdlib>
+  #include <fcntl.h>
+  #include <poll.h>
+  #include <signal.h>
+  #include <sys/ioctl.h>
+  #include <sys/wait.h>
+  #include <termios.h>
+  #include <thread>
+  #include <unistd.h>
+  #include <vector>
+
+namespace
+{
+
+// The library reads its controlling terminal. To not read the terminal running the tests, each test case runs again in a child process whose controlling terminal is a pty driven by the parent.
+const char* const child_variable{"CPPTERMINAL_INPUT_TEST_CHILD"};
+
+bool in_child() { return std::getenv(child_variable) != nullptr; }
+
+// In the child: the bytes sent by the parent are read one by one.
+void set_raw()
+{
+  ::termios raw{};
+  ::tcgetattr(STDIN_FILENO, &raw);
+  ::cfmakeraw(&raw);
+  ::tcsetattr(STDIN_FILENO, TCSANOW, &raw);
+}
+
+// In the child: number of bytes sent by the parent not read yet.
+int unread()
+{
+  int pending{0};
+  ::ioctl(STDIN_FILENO, FIONREAD, &pending);
+  return pending;
+}
+
+// In the child: tell the parent where we are.
+void mark(const std::string& marker)
+{
+  std::fputs(("<" + marker + ">").c_str(), stdout);
+  std::fflush(stdout);
+}
+
+class Pty
+{
+public:
+  explicit Pty(const std::string& test_case)
+  {
+    m_master = ::posix_openpt(O_RDWR | O_NOCTTY);
+    REQUIRE(m_master != -1);
+    REQUIRE(::grantpt(m_master) == 0);
+    REQUIRE(::unlockpt(m_master) == 0);
+    resize(24, 80);
+    const std::string slave{::ptsname(m_master)};
+    const std::string filter{"--test-case=" + test_case};
+    m_child = ::fork();
+    REQUIRE(m_child != -1);
+    if(m_child == 0)
+    {
+      ::setsid();
+      const int fd{::open(slave.c_str(), O_RDWR)};  // becomes the controlling terminal
+      ::dup2(fd, STDIN_FILENO);
+      ::dup2(fd, STDOUT_FILENO);
+      ::dup2(fd, STDERR_FILENO);
+      ::setenv(child_variable, "1", 1);
+      ::execl("/proc/self/exe", "/proc/self/exe", filter.c_str(), static_cast<char*>(nullptr));
+      ::_exit(127);
+    }
+  }
+  Pty(const Pty&)            = delete;
+  Pty(Pty&&)                 = delete;
+  Pty& operator=(const Pty&) = delete;
+  Pty& operator=(Pty&&)      = delete;
+  ~Pty()
+  {
+    if(m_child > 0)
+    {
+      ::kill(m_child, SIGKILL);
+      ::waitpid(m_child, nullptr, 0);
+    }
+    ::close(m_master);
+  }
+
+  void resize(const unsigned short& rows, const unsigned short& columns) const
+  {
+    const ::winsize size{rows, columns, 0, 0};
+    ::ioctl(m_master, TIOCSWINSZ, &size);
+  }
+
+  void send(const std::string& str) const { CHECK(::write(m_master, str.data(), str.size()) == static_cast<::ssize_t>(str.size())); }
+
+  // Read the output of the child until it marks \b marker.
+  bool wait_for(const std::string& marker, const std::chrono::milliseconds& timeout = std::chrono::milliseconds(5000))
+  {
+    const std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::now() + timeout};
+    while(m_output.find("<" + marker + ">", m_seen) == std::string::npos)
+    {
+      if(std::chrono::steady_clock::now() >= deadline || !read(std::chrono::milliseconds(50))) return false;
+    }
+    m_seen = m_output.find("<" + marker + ">", m_seen) + marker.size() + 2;
+    return true;
+  }
+
+  // Wait for the end of the child and give its exit code (its doctest report is in output()), -1 if it has been killed by a signal.
+  int exit_code()
+  {
+    const std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::now() + std::chrono::seconds(30)};
+    while(std::chrono::steady_clock::now() < deadline && read(std::chrono::milliseconds(50))) {}
+    ::kill(m_child, SIGKILL);  // stuck
+    int status{0};
+    ::waitpid(m_child, &status, 0);
+    m_child = -1;
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+  }
+
+  const std::string& output() const noexcept { return m_output; }
+
+private:
+  // Read what the child wrote, answering the cursor position queries. false once the child has closed the pty.
+  bool read(const std::chrono::milliseconds& timeout)
+  {
+    ::pollfd pfd{m_master, POLLIN, 0};
+    if(::poll(&pfd, 1, static_cast<int>(timeout.count())) != 1) return true;
+    char          buffer[4096];
+    const ssize_t size{::read(m_master, buffer, sizeof(buffer))};
+    if(size <= 0) return false;
+    m_output.append(buffer, static_cast<std::size_t>(size));
+    for(std::size_t query = m_output.find("\033[6n", m_query); query != std::string::npos; query = m_output.find("\033[6n", m_query))
+    {
+      send("\033[1;1R");
+      m_query = query + 4;
+    }
+    return true;
+  }
+  int         m_master{-1};
+  ::pid_t     m_child{-1};
+  std::string m_output;
+  std::size_t m_seen{0};
+  std::size_t m_query{0};
+};
+
+}  // namespace
+
+TEST_CASE("Threadless input")
+{
+  if(!in_child())
+  {
+    Pty pty("Threadless input");
+    REQUIRE(pty.wait_for("ready"));
+    pty.send("a");
+    REQUIRE(pty.wait_for("read"));
+    pty.send("b");
+    const int code{pty.exit_code()};
+    INFO(pty.output());
+    CHECK(code == 0);
+    return;
+  }
+  set_raw();
+  Term::set_input_mode(Term::InputMode::Threadless);
+  CHECK(Term::poll_input(std::chrono::milliseconds::zero()) == 0);
+  CHECK(Term::try_read_event().empty());
+  // Nothing reads in the background, the descriptor is readable when the terminal has input.
+  ::pollfd pfd{Term::event_queue_fd(), POLLIN, 0};
+  CHECK(::poll(&pfd, 1, 0) == 0);
+  mark("ready");
+  REQUIRE(::poll(&pfd, 1, 5000) == 1);
+  const Term::Event event{Term::try_read_event()};
+  REQUIRE(event.get_if_key() != nullptr);
+  CHECK(*event.get_if_key() == Term::Key::a);
+  CHECK(Term::try_read_event().empty());
+  CHECK(::poll(&pfd, 1, 0) == 0);
+  mark("read");
+  // Read on the caller's thread by the call.
+  const Term::Event next{Term::read_event_for(std::chrono::milliseconds(5000))};
+  REQUIRE(next.get_if_key() != nullptr);
+  CHECK(*next.get_if_key() == Term::Key::b);
+  CHECK_THROWS_AS(Term::set_input_mode(Term::InputMode::Thread), Term::Exception);
+}
+
+TEST_CASE("Stop and restart reading")
+{
+  if(!in_child())
+  {
+    Pty pty("Stop and restart reading");
+    REQUIRE(pty.wait_for("ready"));
+    pty.send("a");
+    REQUIRE(pty.wait_for("stopped"));
+    pty.send("b");
+    REQUIRE(pty.wait_for("restarted"));
+    pty.send("c");
+    REQUIRE(pty.wait_for("full"));
+    pty.send("d");
+    REQUIRE(pty.wait_for("queued"));
+    pty.send("e");
+    const int code{pty.exit_code()};
+    INFO(pty.output());
+    CHECK(code == 0);
+    return;
+  }
+  set_raw();
+  CHECK(Term::poll_input(std::chrono::milliseconds::zero()) == 0);
+  mark("ready");
+  CHECK(Term::read_event_for(std::chrono::milliseconds(5000)) == Term::Key(Term::Key::Value::a));
+  // The thread is joined, nothing reads the terminal anymore.
+  Term::stop_reading();
+  mark("stopped");
+  ::pollfd pfd{STDIN_FILENO, POLLIN, 0};
+  REQUIRE(::poll(&pfd, 1, 5000) == 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  CHECK(unread() == 1);
+  // Restart in another mode then in the original one.
+  Term::set_input_mode(Term::InputMode::Threadless);
+  CHECK(Term::read_event_for(std::chrono::milliseconds(5000)) == Term::Key(Term::Key::Value::b));
+  Term::stop_reading();
+  Term::set_input_mode(Term::InputMode::Thread);
+  CHECK(Term::poll_input(std::chrono::milliseconds::zero()) == 0);
+  mark("restarted");
+  CHECK(Term::read_event_for(std::chrono::milliseconds(5000)) == Term::Key(Term::Key::Value::c));
+  // Stopping doesn't hang when the thread waits for room in a full queue.
+  Term::set_event_queue_capacity(1, Term::OverflowPolicy::Block);
+  mark("full");
+  CHECK(Term::poll_input(std::chrono::milliseconds(5000)) == 1);
+  mark("queued");
+  const std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::now() + std::chrono::seconds(5)};
+  while(unread() != 0 && std::chrono::steady_clock::now() < deadline) { std::this_thread::sleep_for(std::chrono::milliseconds(10)); }
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+  Term::stop_reading();
+  CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+  CHECK(Term::event_queue_waits() == 1);
+  CHECK(Term::event_queue_overflows() == 1);  // e
+  CHECK(Term::try_read_event() == Term::Key(Term::Key::Value::d));
+}
+
+TEST_CASE("Concurrent first read")
+{
+  if(!in_child())
+  {
+    Pty pty("Concurrent first read");
+    REQUIRE(pty.wait_for("ready"));
+    pty.send("a");
+    const int code{pty.exit_code()};
+    INFO(pty.output());
+    CHECK(code == 0);
+    return;
+  }
+  set_raw();
+  // All the threads start reading at the same time, a single reading thread must be started.
+  std::atomic<bool>        go{false};
+  std::vector<std::thread> readers;
+  for(std::size_t i = 0; i != 8; ++i)
+  {
+    readers.emplace_back(
+      [&go]()
+      {
+        while(!go.load()) { std::this_thread::yield(); }
+        Term::poll_input(std::chrono::milliseconds::zero());
+      });
+  }
+  go.store(true);
+  for(std::thread& reader: readers) { reader.join(); }
+  mark("ready");
+  CHECK(Term::read_event_for(std::chrono::milliseconds(5000)) == Term::Key(Term::Key::Value::a));
+  const std::chrono::steady_clock::time_point start{std::chrono::steady_clock::now()};
+  Term::stop_reading();
+  CHECK(std::chrono::steady_clock::now() - start < std::chrono::seconds(1));
+}
+
+TEST_CASE("Resize debounce and size cache")
+{
+  if(!in_child())
+  {
+    Pty pty("Resize debounce and size cache");
+    REQUIRE(pty.wait_for("ready"));
+    pty.resize(30, 100);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pty.resize(31, 101);
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    pty.resize(32, 102);
+    REQUIRE(pty.wait_for("immediate"));
+    pty.resize(40, 120);
+    const int code{pty.exit_code()};
+    INFO(pty.output());
+    CHECK(code == 0);
+    return;
+  }
+  set_raw();
+  const Term::Screen initial({Term::Rows(24), Term::Columns(80)});
+  const Term::Screen last({Term::Rows(32), Term::Columns(102)});
+  Term::set_resize_debounce(std::chrono::milliseconds(200));
+  CHECK(Term::poll_input(std::chrono::milliseconds::zero()) == 0);
+  CHECK(Term::screen_size() == initial);
+  mark("ready");
+  // The cached size is dropped at the first resize, the terminal is asked until the size settles.
+  const std::chrono::steady_clock::time_point deadline{std::chrono::steady_clock::now() + std::chrono::seconds(5)};
+  while(Term::screen_size() == initial && std::chrono::steady_clock::now() < deadline) { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }
+  CHECK(Term::screen_size() != initial);
+  CHECK(Term::poll_input(std::chrono::milliseconds::zero()) == 0);
+  // The burst is delivered as a single event with the final size.
+  const Term::Event event{Term::read_event_for(std::chrono::milliseconds(5000))};
+  REQUIRE(event.get_if_screen() != nullptr);
+  CHECK(*event.get_if_screen() == last);
+  CHECK(Term::read_event_for(std::chrono::milliseconds(500)).empty());
+  CHECK(Term::screen_size() == last);
+  // Without debounce each resize is delivered and cached at once.
+  Term::set_resize_debounce(std::chrono::milliseconds::zero());
+  mark("immediate");
+  const Term::Event resized{Term::read_event_for(std::chrono::milliseconds(5000))};
+  REQUIRE(resized.get_if_screen() != nullptr);
+  CHECK(*resized.get_if_screen() == Term::Screen({Term::Rows(40), Term::Columns(120)}));
+  CHECK(Term::screen_size() == Term::Screen({Term::Rows(40), Term::Columns(120)}));
+}
+
+TEST_CASE("Restore the terminal on a signal with asynchronous output")
+{
+  if(!in_child())
+  {
+    Pty pty("Restore the terminal on a signal with asynchronous output");
+    REQUIRE(pty.wait_for("ready"));
+    const std::size_t ready{pty.output().size()};
+    // Not reading fills the pty: the writer is still busy with the frame when the cleanup writes.
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    const int         code{pty.exit_code()};
+    const std::string restored{pty.output().substr(ready)};
+    INFO(pty.output());
+    CHECK(code == -1);
+    CHECK(restored.find("\033[?25h") != std::string::npos);    // cursor_on
+    CHECK(restored.find("\033[?1049l") != std::string::npos);  // screen_load
+    return;
+  }
+  Term::terminal.setOptions(Term::Option::Raw, Term::Option::ClearScreen, Term::Option::NoCursor);
+  mark("ready");
+  Term::set_async_output(true);
+  Term::submit_frame(std::string(200000, 'x'));
+  std::raise(SIGTERM);
+}
+
+TEST_CASE("Output stays asynchronous after a non-fatal signal")
+{
+  if(!in_child())
+  {
+    Pty pty("Output stays asynchronous after a non-fatal signal");
+    REQUIRE(pty.wait_for("ready"));
+    // Not reading fills the pty: a synchronous write would wait for it.
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    const int code{pty.exit_code()};
+    INFO(pty.output());
+    CHECK(code == 0);
+    return;
+  }
+  set_raw();
+  Term::set_async_output(true);
+  mark("ready");
+  // The terminal is cleaned up for every handled signal, the restore writes only are written directly.
+  std::raise(SIGCHLD);
+  Term::submit_frame(std::string(200000, 'x'));
+  CHECK(Term::output_backlog().pending != 0);
+}
+#endif
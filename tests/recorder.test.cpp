@@ -0,0 +1,64 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#if !defined(BUILD_MONOLITHIC)
+  #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#endif
+#include "cpp-terminal/private/recorder.hpp"
+
+#include "doctest/doctest.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+TEST_CASE("asciicast recording")
+{
+  const std::string path{"recorder.test.cast"};
+  {
+    Term::Private::Recorder recorder(path, Term::Screen({Term::Rows(24), Term::Columns(80)}));
+    const std::string       hello{"hello \"world\"\r\n\x1b[0m"};
+    recorder.output(hello.data(), hello.size());
+    const std::string e_acute{"\xC3\xA9"};
+    recorder.output(e_acute.data(), 1);  // the sequence is cut by the write
+    recorder.output(e_acute.data() + 1, 1);
+    recorder.resize(Term::Screen({Term::Rows(30), Term::Columns(100)}));
+  }
+  std::ifstream            file(path);
+  std::vector<std::string> lines;
+  for(std::string line; std::getline(file, line);) { lines.push_back(line); }
+  REQUIRE(lines.size() == 4);
+  CHECK(lines[0].find("{\"version\": 2, \"width\": 80, \"height\": 24, \"timestamp\": ") == 0);
+  CHECK(lines[1].find(", \"o\", \"hello \\\"world\\\"\\r\\n\\u001b[0m\"]") != std::string::npos);
+  CHECK(lines[2].find(", \"o\", \"\xC3\xA9\"]") != std::string::npos);
+  CHECK(lines[3].find(", \"r\", \"100x30\"]") != std::string::npos);
+  file.close();
+  std::remove(path.c_str());
+}
+
+TEST_CASE("asciicast recording of invalid utf8")
+{
+  const std::string path{"recorder.invalid.test.cast"};
+  {
+    Term::Private::Recorder recorder(path, Term::Screen({Term::Rows(24), Term::Columns(80)}));
+    const std::string       invalid{"a\xFF" "b\xC0\xAF" "c\xED\xA0\x80" "d\xE2\x82" "e\xF4\x90\x80\x80" "f\xF0\x9F\x98\x80"};
+    recorder.output(invalid.data(), invalid.size());
+  }
+  std::ifstream            file(path);
+  std::vector<std::string> lines;
+  for(std::string line; std::getline(file, line);) { lines.push_back(line); }
+  REQUIRE(lines.size() == 2);
+  // Stray byte, overlong form, surrogate, truncated sequence and beyond U+10FFFF are replaced byte by byte, the valid sequence is kept.
+  const std::string replaced{"a\\ufffdb\\ufffd\\ufffdc\\ufffd\\ufffd\\ufffdd\\ufffd\\ufffde\\ufffd\\ufffd\\ufffd\\ufffdf\xF0\x9F\x98\x80"};
+  CHECK(lines[1].find(", \"o\", \"" + replaced + "\"]") != std::string::npos);
+  file.close();
+  std::remove(path.c_str());
+}
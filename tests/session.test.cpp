@@ -0,0 +1,114 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#if !defined(BUILD_MONOLITHIC)
+  #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#endif
+#include "cpp-terminal/session.hpp"
+
+#include "cpp-terminal/key.hpp"
+#include "cpp-terminal/mouse.hpp"
+#include "cpp-terminal/private/file.hpp"
+#include "doctest/doctest.h"
+
+#include <mutex>
+#include <string>
+
+#if !defined(_WIN32)
+  #include <fcntl.h>
+  #include <sys/socket.h>
+  #include <unistd.h>
+
+TEST_CASE("Session over a socket")
+{
+  int fds[2]{-1, -1};
+  REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  {
+    Term::Session session(fds[0], fds[0]);
+    CHECK(session.inputFd() != fds[0]);  // duplicated
+    CHECK(session.screen().empty());     // not a tty
+    CHECK(session.read(std::chrono::milliseconds(0)).empty());
+
+    CHECK(::write(fds[1], "a", 1) == 1);
+    const Term::Event event{session.read(std::chrono::milliseconds(1000))};
+    REQUIRE(event.get_if_key() != nullptr);
+    CHECK(*event.get_if_key() == Term::Key::a);
+
+    const std::string hello{"hello"};
+    const std::string world{" world"};
+    CHECK(session.write({hello, world}) == 11);
+    std::string received(11, '\0');
+    CHECK(::read(fds[1], &received[0], received.size()) == 11);
+    CHECK(received == "hello world");
+    CHECK(session.outputStats().bytes == 11);
+
+    ::close(fds[1]);
+    CHECK(session.connected());
+    CHECK(session.read(std::chrono::milliseconds(1000)).empty());
+    CHECK(!session.connected());
+  }
+  ::close(fds[0]);
+}
+
+TEST_CASE("Session mouse clicks")
+{
+  int first[2]{-1, -1};
+  int second[2]{-1, -1};
+  REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, first) == 0);
+  REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, second) == 0);
+  {
+    Term::Session     session(first[0], first[0]);
+    Term::Session     other(second[0], second[0]);
+    const std::string press{"\033[<0;3;4M"};
+    const std::string release{"\033[<0;3;4m"};
+    const auto        action = [](Term::Session& from, const int& fd, const std::string& report)
+    {
+      CHECK(::write(fd, report.data(), report.size()) == static_cast<::ssize_t>(report.size()));
+      const Term::Event event{from.read(std::chrono::milliseconds(1000))};
+      REQUIRE(event.get_if_mouse() != nullptr);
+      return event.get_if_mouse()->getButton().action();
+    };
+    CHECK(action(session, first[1], press) == Term::Button::Action::Pressed);
+    CHECK(action(session, first[1], release) == Term::Button::Action::Released);
+    // Each session keeps its own click history.
+    CHECK(action(other, second[1], press) == Term::Button::Action::Pressed);
+    CHECK(action(session, first[1], press) == Term::Button::Action::DoubleClicked);
+  }
+  ::close(first[0]);
+  ::close(first[1]);
+  ::close(second[0]);
+  ::close(second[1]);
+}
+
+TEST_CASE("Session output mode and the caller's descriptor")
+{
+  int fds[2]{-1, -1};
+  REQUIRE(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+  {
+    Term::Session session(fds[0], fds[0]);
+    session.setOutputMode(Term::OutputMode::NonBlocking);
+    // The duplicate shares the file description, and so the flag.
+    CHECK((::fcntl(fds[0], F_GETFL) & O_NONBLOCK) != 0);
+    // Nothing to read on a non-blocking descriptor isn't the end of the input.
+    std::recursive_mutex            mutex;
+    Term::Private::InputFileHandler input(mutex, fds[0]);
+    std::string                     buffer;
+    CHECK(input.read(buffer) == 0);
+    CHECK(!input.eof());
+    CHECK(session.read(std::chrono::milliseconds(0)).empty());
+    CHECK(session.connected());
+    ::shutdown(fds[1], SHUT_WR);
+    CHECK(input.read(buffer) == 0);
+    CHECK(input.eof());
+  }
+  CHECK((::fcntl(fds[0], F_GETFL) & O_NONBLOCK) == 0);
+  ::close(fds[0]);
+  ::close(fds[1]);
+}
+#endif
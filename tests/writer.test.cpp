@@ -0,0 +1,133 @@
+/*
+* cpp-terminal
+* C++ library for writing multi-platform terminal applications.
+*
+* SPDX-FileCopyrightText: 2019-2025 cpp-terminal
+*
+* SPDX-License-Identifier: MIT
+*/
+
+#if !defined(BUILD_MONOLITHIC)
+  #define DOCTEST_CONFIG_IMPLEMENT_WITH_MAIN
+#endif
+#include "cpp-terminal/private/writer.hpp"
+
+#include "doctest/doctest.h"
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+
+TEST_CASE("Writer keeps the order")
+{
+  std::string written;
+  std::size_t calls{0};
+  {
+    Term::Private::Writer writer(
+      [&written, &calls](const std::string& data)
+      {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        written += data;
+        ++calls;
+      });
+    for(std::size_t i = 0; i != 100; ++i) { writer.write(std::to_string(i) + ";"); }
+    writer.drain();
+    std::string expected;
+    for(std::size_t i = 0; i != 100; ++i) { expected += std::to_string(i) + ";"; }
+    CHECK(written == expected);
+    // The writes done while the thread was busy have been batched.
+    CHECK(calls < 100);
+    const std::string head{"e"};
+    const std::string tail{"nd"};
+    writer.write({head, tail});
+  }
+  CHECK(written.substr(written.size() - 3) == "end");
+}
+
+TEST_CASE("Latest frame wins")
+{
+  std::string                  written;
+  std::mutex                   gate;
+  std::unique_lock<std::mutex> blocked(gate);
+  Term::Private::Writer writer(
+    [&written, &gate](const std::string& data)
+    {
+      const std::lock_guard<std::mutex> lock(gate);
+      written += data;
+    });
+  // The first write blocks the thread until the gate is opened.
+  writer.write("[");
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  CHECK(writer.writeFrame("frame1", 1) == Term::Private::Writer::FrameStatus::Queued);
+  writer.write("a");
+  CHECK(writer.writeFrame("frame2", 2) == Term::Private::Writer::FrameStatus::Replaced);
+  writer.write("b");
+  CHECK(writer.writtenFrame() == 0);
+  blocked.unlock();
+  writer.drain();
+  CHECK(written == "[aframe2b");
+  CHECK(writer.writtenFrame() == 2);
+}
+
+TEST_CASE("Frame being written is committed")
+{
+  std::string                  written;
+  std::atomic<bool>            writing{false};
+  std::mutex                   gate;
+  std::unique_lock<std::mutex> blocked(gate);
+  Term::Private::Writer writer(
+    [&written, &writing, &gate](const std::string& data)
+    {
+      writing = true;
+      const std::lock_guard<std::mutex> lock(gate);
+      written += data;
+    });
+  // The sink holds frame 1 until the gate is opened.
+  CHECK(writer.writeFrame("frame1", 1) == Term::Private::Writer::FrameStatus::Queued);
+  while(!writing) { std::this_thread::yield(); }
+  CHECK(writer.committedFrame() == 1);
+  CHECK(writer.writtenFrame() == 0);
+  // Frame 1 can't be replaced anymore, the next frames are written after it.
+  CHECK(writer.writeFrame("frame2", 2) == Term::Private::Writer::FrameStatus::Queued);
+  CHECK(writer.writeFrame("frame3", 3) == Term::Private::Writer::FrameStatus::Replaced);
+  CHECK(writer.committedFrame() == 1);
+  blocked.unlock();
+  writer.drain();
+  CHECK(written == "frame1frame3");
+  CHECK(writer.committedFrame() == 3);
+  CHECK(writer.writtenFrame() == 3);
+}
+
+TEST_CASE("Diff against a stale frame")
+{
+  std::string                  written;
+  std::atomic<bool>            writing{false};
+  std::mutex                   gate;
+  std::unique_lock<std::mutex> blocked(gate);
+  Term::Private::Writer writer(
+    [&written, &writing, &gate](const std::string& data)
+    {
+      writing = true;
+      const std::lock_guard<std::mutex> lock(gate);
+      written += data;
+    },
+    4);
+  CHECK(writer.committedFrame() == 4);
+  CHECK(writer.writtenFrame() == 4);
+  // The sink holds frame 5, diffed against the frame written before the writer.
+  CHECK(writer.writeFrame("frame5", 5, 4) == Term::Private::Writer::FrameStatus::Queued);
+  while(!writing) { std::this_thread::yield(); }
+  // Frame 6 was computed against frame 4 but frame 5 has been committed in between.
+  CHECK(writer.writeFrame("frame6", 6, 4) == Term::Private::Writer::FrameStatus::Stale);
+  CHECK(writer.pending() == 6);
+  CHECK(writer.writeFrame("frame7", 7, 5) == Term::Private::Writer::FrameStatus::Queued);
+  // The pending frame 7 isn't committed: a diff against it is stale too, a full redraw replaces it.
+  CHECK(writer.writeFrame("frame8", 8, 7) == Term::Private::Writer::FrameStatus::Stale);
+  CHECK(writer.writeFrame("frame9", 9) == Term::Private::Writer::FrameStatus::Replaced);
+  blocked.unlock();
+  writer.drain();
+  CHECK(written == "frame5frame9");
+  CHECK(writer.writtenFrame() == 9);
+}